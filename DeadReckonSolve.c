@@ -0,0 +1,199 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "DeadReckonSolve.h"
+
+#define DR_EARTH_RADIUS 6371000.0     // 与calculate_distance保持一致
+#define DR_KNOTS_TO_MS 0.514444444    // 节 -> 米/秒
+#define DR_KMH_TO_MS (1.0 / 3.6)      // 公里/小时 -> 米/秒
+#define DR_MAX_TURN_RATE 30.0         // 角速度上限（度/秒），防止航向噪声造成发散
+#define DR_MIN_TURN_RATE 1e-3         // 角速度低于此值按直线处理（度/秒）
+
+void gps_dr_init(gps_dr_t* dr, int model, double max_age) {
+    memset(dr, 0, sizeof(gps_dr_t));
+    atomic_init(&dr->sequence, 0);
+    dr->model = model;
+    dr->max_age = max_age;
+    dr->min_turn_speed = 1.0;
+}
+
+// 航向差归一化到[-180, 180)
+static double dr_wrap_course_delta(double delta) {
+    while (delta >= 180.0) {
+        delta -= 360.0;
+    }
+    while (delta < -180.0) {
+        delta += 360.0;
+    }
+    return delta;
+}
+
+// 写入端发布：序号先变为奇数，写完后再变为偶数
+static void dr_publish(gps_dr_t* dr, const gps_dr_fix_t* fix) {
+    unsigned seq = atomic_load_explicit(&dr->sequence, memory_order_relaxed);
+    atomic_store_explicit(&dr->sequence, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    dr->fix = *fix;
+    atomic_store_explicit(&dr->sequence, seq + 2, memory_order_release);
+}
+
+// 取出本历元的速度，优先RMC，其次VTG
+static int dr_epoch_velocity(const gps_data_t* data, double* speed, double* course) {
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    if (rmc->has_speed && rmc->has_course && rmc->status != 0) {
+        *speed = GPS_TO_DOUBLE(rmc->speed_over_ground, SPEED) * DR_KNOTS_TO_MS;
+        *course = GPS_TO_DOUBLE(rmc->course_over_ground, ANGLE);
+        return 1;
+    }
+
+    const gps_vtg_t* vtg = gps_data_vtg(data);
+    if (vtg->has_true_course && vtg->mode != 3) {
+        if (vtg->has_speed_kmh) {
+            *speed = GPS_TO_DOUBLE(vtg->speed_kmh, SPEED) * DR_KMH_TO_MS;
+        } else if (vtg->has_speed_knots) {
+            *speed = GPS_TO_DOUBLE(vtg->speed_knots, SPEED) * DR_KNOTS_TO_MS;
+        } else {
+            return 0;
+        }
+        *course = GPS_TO_DOUBLE(vtg->course_true, ANGLE);
+        return 1;
+    }
+    return 0;
+}
+
+// 用一个完整历元更新推算起点，timestamp为该历元定位对应的本地时刻
+// 返回：0=已更新，-1=空指针，-2=没有有效定位，-4=定位语句的时刻没有前进（上一个历元留下的旧数据）
+// 旧数据不能刷新起点，否则推算时长被重置，拿旧位置当成新定位
+int gps_dr_update(gps_dr_t* dr, const gps_data_t* data, double timestamp) {
+    if (dr == NULL || data == NULL) {
+        return -1;
+    }
+
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    gps_dr_fix_t fix = {0};
+    int fresh;
+    if (gga->has_latitude && gga->has_longitude && gga->fix_quality > 0) {
+        fix.latitude = GPS_TO_DOUBLE(gga->latitude, DEGREE);
+        fix.longitude = GPS_TO_DOUBLE(gga->longitude, DEGREE);
+        fresh = !gga->has_time || gps_tod_mark_advance(&dr->fix_mark, gga->hour, gga->minute, gga->second);
+    } else if (rmc->has_latitude && rmc->has_longitude && rmc->status == 1) {
+        fix.latitude = GPS_TO_DOUBLE(rmc->latitude, DEGREE);
+        fix.longitude = GPS_TO_DOUBLE(rmc->longitude, DEGREE);
+        fresh = !rmc->has_time || gps_tod_mark_advance(&dr->fix_mark, rmc->hour, rmc->minute, rmc->second);
+    } else {
+        return -2;
+    }
+    if (!fresh) {
+        return -4;
+    }
+    fix.timestamp = timestamp;
+    fix.valid = 1;
+
+    double speed, course;
+    if (dr_epoch_velocity(data, &speed, &course)) {
+        fix.speed = speed;
+        fix.course = course;
+        fix.has_velocity = 1;
+
+        // 由相邻两次航向估计角速度，低速时航向是噪声，不参与计算
+        if (speed >= dr->min_turn_speed) {
+            double dt = timestamp - dr->prev_course_time;
+            if (dr->has_prev_course && dt > 0.0 && dt <= dr->max_age) {
+                double rate = dr_wrap_course_delta(course - dr->prev_course) / dt;
+                if (rate > DR_MAX_TURN_RATE) {
+                    rate = DR_MAX_TURN_RATE;
+                } else if (rate < -DR_MAX_TURN_RATE) {
+                    rate = -DR_MAX_TURN_RATE;
+                }
+                fix.turn_rate = rate;
+            }
+            dr->prev_course = course;
+            dr->prev_course_time = timestamp;
+            dr->has_prev_course = 1;
+        } else {
+            dr->has_prev_course = 0;
+        }
+    } else {
+        dr->has_prev_course = 0;
+    }
+
+    dr_publish(dr, &fix);
+    return 0;
+}
+
+// 读取端：复制前后序号一致且为偶数才算读到完整数据
+int gps_dr_get_fix(const gps_dr_t* dr, gps_dr_fix_t* fix) {
+    if (dr == NULL || fix == NULL) {
+        return -1;
+    }
+    for (;;) {
+        unsigned begin = atomic_load_explicit(&dr->sequence, memory_order_acquire);
+        if (begin & 1u) {
+            continue;
+        }
+        *fix = dr->fix;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&dr->sequence, memory_order_relaxed) == begin) {
+            break;
+        }
+    }
+    return fix->valid ? 0 : -3;
+}
+
+// 推算timestamp时刻的位置，超过最大推算时长时结果截止在max_age并返回-2
+int gps_dr_position_at(const gps_dr_t* dr, double timestamp, gps_dr_estimate_t* estimate) {
+    if (dr == NULL || estimate == NULL) {
+        return -1;
+    }
+
+    gps_dr_fix_t fix;
+    if (gps_dr_get_fix(dr, &fix) != 0) {
+        return -3;
+    }
+
+    int ret = 0;
+    double age = timestamp - fix.timestamp;
+    if (age < 0.0) {
+        age = 0.0;
+    } else if (age > dr->max_age) {
+        age = dr->max_age;
+        ret = -2;
+    }
+
+    estimate->latitude = fix.latitude;
+    estimate->longitude = fix.longitude;
+    estimate->speed = fix.has_velocity ? fix.speed : 0.0;
+    estimate->course = fix.course;
+    estimate->age = timestamp - fix.timestamp;
+    if (!fix.has_velocity || age == 0.0) {
+        return ret;
+    }
+
+    // 在局部东北平面内积分位移
+    double c0 = fix.course * M_PI / 180.0;
+    double east, north;
+    if (dr->model == GPS_DR_MODEL_CONSTANT_TURN && fabs(fix.turn_rate) > DR_MIN_TURN_RATE) {
+        double w = fix.turn_rate * M_PI / 180.0;
+        double c1 = c0 + w * age;
+        east = fix.speed / w * (cos(c0) - cos(c1));
+        north = fix.speed / w * (sin(c1) - sin(c0));
+        estimate->course = fmod(fix.course + fix.turn_rate * age, 360.0);
+        if (estimate->course < 0.0) {
+            estimate->course += 360.0;
+        }
+    } else {
+        east = fix.speed * age * sin(c0);
+        north = fix.speed * age * cos(c0);
+    }
+
+    estimate->latitude += north / DR_EARTH_RADIUS * 180.0 / M_PI;
+    estimate->longitude += east / (DR_EARTH_RADIUS * cos(fix.latitude * M_PI / 180.0)) * 180.0 / M_PI;
+    if (estimate->longitude >= 180.0) {
+        estimate->longitude -= 360.0;
+    } else if (estimate->longitude < -180.0) {
+        estimate->longitude += 360.0;
+    }
+    return ret;
+}
@@ -0,0 +1,60 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_DEADRECKONSOLVE_H
+#define NMEA0183_DEADRECKONSOLVE_H
+#include <stdatomic.h>
+#include "NMEA0183Solve.h"
+#include "GnssTime.h"
+
+// 两次定位之间的航位推算
+// 写入端（解析线程）只有一个，读取端可以有多个，用顺序锁(seqlock)保证读到一致的数据，读取端不会阻塞写入端
+// 时间戳由调用方提供，只要求写入与查询使用同一个时钟（如CLOCK_MONOTONIC的秒数）
+
+#define GPS_DR_MODEL_LINEAR 0         // 匀速直线
+#define GPS_DR_MODEL_CONSTANT_TURN 1  // 匀速匀角速度转弯
+
+// 最近一次定位及运动状态
+typedef struct {
+    double latitude;           // 纬度（度）
+    double longitude;          // 经度（度）
+    double speed;              // 地面速率（米/秒）
+    double course;             // 地面航向（度）
+    double turn_rate;          // 转向角速度（度/秒，顺时针为正）
+    double timestamp;          // 定位对应的本地时刻（秒）
+    int has_velocity;
+    int valid;
+} gps_dr_fix_t;
+
+// 查询结果
+typedef struct {
+    double latitude;           // 纬度（度）
+    double longitude;          // 经度（度）
+    double speed;              // 地面速率（米/秒）
+    double course;             // 推算后的航向（度）
+    double age;                // 推算时长（秒），即距最近一次定位的时间
+} gps_dr_estimate_t;
+
+typedef struct {
+    atomic_uint sequence;      // 奇数表示正在写入
+    gps_dr_fix_t fix;
+
+    // 初始化后只读
+    int model;
+    double max_age;            // 最大推算时长（秒）
+
+    // 以下只由写入端访问
+    double min_turn_speed;     // 低于此速度时航向不可信，不计算角速度（米/秒）
+    double prev_course;
+    double prev_course_time;
+    int has_prev_course;
+    gps_tod_mark_t fix_mark;   // 上次用作推算起点的语句时刻，旧语句不再刷新起点
+} gps_dr_t;
+
+void gps_dr_init(gps_dr_t* dr, int model, double max_age);
+int gps_dr_update(gps_dr_t* dr, const gps_data_t* data, double timestamp);
+int gps_dr_get_fix(const gps_dr_t* dr, gps_dr_fix_t* fix);
+int gps_dr_position_at(const gps_dr_t* dr, double timestamp, gps_dr_estimate_t* estimate);
+
+#endif // NMEA0183_DEADRECKONSOLVE_H
@@ -0,0 +1,134 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "EpochNotify.h"
+
+#if GPS_ENABLE_NOTIFY_WAIT
+#include <limits.h>
+#include <sched.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+static atomic_uint epoch_sequence; // 已完成的历元数，也是futex字
+static gps_epoch_callback_t epoch_callback;
+static void* epoch_callback_user;
+
+#if GPS_ENABLE_NOTIFY_WAIT
+static atomic_int event_fds[GPS_NOTIFY_MAX_EVENTFDS]; // 存fd+1，0表示空位
+static atomic_uint eventfd_writers; // 正在写eventfd的发布端个数，关闭时等它们写完，免得写到被复用的fd号上
+static atomic_uint futex_waiters;
+#endif
+
+// 设置历元回调，传NULL取消；在solve_once所在线程调用，回调里不要阻塞
+void gps_notify_set_callback(gps_epoch_callback_t callback, void* user) {
+    epoch_callback = callback;
+    epoch_callback_user = user;
+}
+
+// 当前已完成的历元序号
+uint32_t gps_notify_sequence(void) {
+    return atomic_load_explicit(&epoch_sequence, memory_order_acquire);
+}
+
+// 由solve_once在gps_data发布之后调用
+void gps_notify_epoch(const gps_data_t* data) {
+    uint32_t sequence = atomic_fetch_add_explicit(&epoch_sequence, 1, memory_order_seq_cst) + 1;
+#if GPS_ENABLE_NOTIFY_WAIT
+    if (atomic_load_explicit(&futex_waiters, memory_order_seq_cst) != 0) {
+        syscall(SYS_futex, &epoch_sequence, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+    }
+    atomic_fetch_add_explicit(&eventfd_writers, 1, memory_order_seq_cst);
+    for (int i = 0; i < GPS_NOTIFY_MAX_EVENTFDS; i++) {
+        int fd = atomic_load_explicit(&event_fds[i], memory_order_seq_cst) - 1;
+        if (fd >= 0) {
+            uint64_t one = 1;
+            ssize_t written = write(fd, &one, sizeof(one)); // 计数器满时EAGAIN，读取端总会先读走
+            (void) written;
+        }
+    }
+    atomic_fetch_sub_explicit(&eventfd_writers, 1, memory_order_seq_cst);
+#endif
+    if (epoch_callback != NULL) {
+        epoch_callback(data, sequence, epoch_callback_user);
+    }
+}
+
+#if GPS_ENABLE_NOTIFY_WAIT
+// 新建一个历元eventfd（非阻塞、CLOEXEC）并登记，之后每个历元都会加1
+// 每个消费者各用一个：共用一个fd时第一个read()就把计数读走了，其它消费者会漏掉这个历元
+// 返回：fd，-2=创建失败，-3=已经有GPS_NOTIFY_MAX_EVENTFDS个
+int gps_notify_eventfd(void) {
+    int created = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (created < 0) {
+        return -2;
+    }
+    for (int i = 0; i < GPS_NOTIFY_MAX_EVENTFDS; i++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong_explicit(&event_fds[i], &expected, created + 1, memory_order_seq_cst,
+                                                    memory_order_relaxed)) {
+            return created;
+        }
+    }
+    close(created);
+    return -3;
+}
+
+// 注销并关闭gps_notify_eventfd返回的fd；不是登记过的fd时什么也不做
+void gps_notify_eventfd_close(int fd) {
+    for (int i = 0; i < GPS_NOTIFY_MAX_EVENTFDS; i++) {
+        int expected = fd + 1;
+        if (fd >= 0 && atomic_compare_exchange_strong_explicit(&event_fds[i], &expected, 0, memory_order_seq_cst,
+                                                               memory_order_relaxed)) {
+            // 发布端可能刚读到这个fd还没写完，等它写完再关
+            while (atomic_load_explicit(&eventfd_writers, memory_order_seq_cst) != 0) {
+                sched_yield();
+            }
+            close(fd);
+            return;
+        }
+    }
+}
+
+// 等到历元序号不等于seen，timeout_ms<0表示一直等；新序号写到sequence（可以为NULL）
+// 返回：0=有新历元，-3=超时
+int gps_notify_wait(uint32_t seen, int timeout_ms, uint32_t* sequence) {
+    uint64_t deadline = 0;
+    if (timeout_ms >= 0) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        deadline = (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec + (uint64_t) timeout_ms * 1000000ull;
+    }
+
+    uint32_t current = gps_notify_sequence();
+    atomic_fetch_add_explicit(&futex_waiters, 1, memory_order_seq_cst);
+    while (current == seen) {
+        struct timespec relative;
+        struct timespec* timeout = NULL;
+        if (timeout_ms >= 0) {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            uint64_t now_ns = (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+            if (now_ns >= deadline) {
+                break;
+            }
+            relative.tv_sec = (time_t) ((deadline - now_ns) / 1000000000ull);
+            relative.tv_nsec = (long) ((deadline - now_ns) % 1000000000ull);
+            timeout = &relative;
+        }
+        // 序号已经变了内核会立即返回EAGAIN；被信号打断也只是重新检查
+        syscall(SYS_futex, &epoch_sequence, FUTEX_WAIT_PRIVATE, seen, timeout, NULL, 0);
+        current = gps_notify_sequence();
+    }
+    atomic_fetch_sub_explicit(&futex_waiters, 1, memory_order_relaxed);
+
+    if (sequence != NULL) {
+        *sequence = current;
+    }
+    return current == seen ? -3 : 0;
+}
+#endif
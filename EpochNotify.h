@@ -0,0 +1,42 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_EPOCHNOTIFY_H
+#define NMEA0183_EPOCHNOTIFY_H
+#include <stdatomic.h>
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+
+// 历元完成通知，代替定时轮询get_gps_data()：
+// 1. 回调：solve_once发布完gps_data后在同一线程里调用
+// 2. eventfd（Linux）：每个历元加1，可以和其它fd一起放进epoll/poll，读出8字节得到期间完成的历元数；
+//    每个消费者调用gps_notify_eventfd()拿自己的fd，互不抢计数，用完gps_notify_eventfd_close()
+// 3. 按序号等待（Linux futex）：gps_notify_wait(上次看到的序号, 超时)，序号变了立即返回
+// 没有等待者时发布端不做任何系统调用（eventfd只在被取用后才写）
+
+#ifndef GPS_ENABLE_NOTIFY_WAIT
+#ifdef __linux__
+#define GPS_ENABLE_NOTIFY_WAIT 1
+#else
+#define GPS_ENABLE_NOTIFY_WAIT 0
+#endif
+#endif
+
+#ifndef GPS_NOTIFY_MAX_EVENTFDS
+#define GPS_NOTIFY_MAX_EVENTFDS 8  // 同时存在的eventfd消费者数上限
+#endif
+
+typedef void (*gps_epoch_callback_t)(const gps_data_t* data, uint32_t sequence, void* user);
+
+void gps_notify_set_callback(gps_epoch_callback_t callback, void* user);
+uint32_t gps_notify_sequence(void);
+void gps_notify_epoch(const gps_data_t* data);
+
+#if GPS_ENABLE_NOTIFY_WAIT
+int gps_notify_eventfd(void);
+void gps_notify_eventfd_close(int fd);
+int gps_notify_wait(uint32_t seen, int timeout_ms, uint32_t* sequence);
+#endif
+
+#endif // NMEA0183_EPOCHNOTIFY_H
@@ -0,0 +1,227 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "FixedPoint.h"
+
+#if GPS_INTEGER_ONLY || GPS_BOUNDED_PARSE
+#include <ctype.h>
+
+// 解析十进制整数，最多读GPS_NUMBER_MAX_CHARS个字符，和atoi一样跳过前导空白、遇到非数字停止
+int gps_parse_int(const char* str) {
+    const char* end = str + GPS_NUMBER_MAX_CHARS;
+    while (str < end && isspace((unsigned char) *str)) {
+        str++;
+    }
+    int negative = 0;
+    if (str < end && (*str == '-' || *str == '+')) {
+        negative = *str == '-';
+        str++;
+    }
+    int32_t value = 0;
+    while (str < end && isdigit((unsigned char) *str)) {
+        if (value < 100000000) {
+            value = value * 10 + (*str - '0');
+        }
+        str++;
+    }
+    return negative ? -value : value;
+}
+
+// 从str开始取两位数字，不是数字返回-1
+static int parse_2digits(const char* str) {
+    if (!isdigit((unsigned char) str[0]) || !isdigit((unsigned char) str[1])) {
+        return -1;
+    }
+    return (str[0] - '0') * 10 + (str[1] - '0');
+}
+
+// 解析 hhmmss.sss，返回值和 sscanf("%2d%2d%lf") 一样是成功解析的字段数
+int gps_parse_hms(const char* str, int* hour, int* minute, gps_second_t* second) {
+    int value = parse_2digits(str);
+    if (value < 0) {
+        return 0;
+    }
+    *hour = value;
+    value = parse_2digits(str + 2);
+    if (value < 0) {
+        return 1;
+    }
+    *minute = value;
+    *second = 0;
+    if (!isdigit((unsigned char) str[4]) && str[4] != '.') {
+        return 2;
+    }
+    *second = GPS_PARSE(str + 4, SECOND);
+    return 3;
+}
+
+// 解析 ddmmyy，返回值和 sscanf("%2d%2d%2d") 一样是成功解析的字段数
+int gps_parse_dmy(const char* str, int* day, int* month, int* year) {
+    int* out[3] = {day, month, year};
+    for (int i = 0; i < 3; i++) {
+        int value = parse_2digits(str + i * 2);
+        if (value < 0) {
+            return i;
+        }
+        *out[i] = value;
+    }
+    return 3;
+}
+#endif
+
+#if GPS_BOUNDED_PARSE && !GPS_INTEGER_ONLY
+#define DECIMAL_MAX_MANTISSA 100000000000000000LL // 1e17，再多的数字不计入尾数
+
+static const double pow10_table[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// 解析十进制小数，最多读GPS_NUMBER_MAX_CHARS个字符
+// 先按整数累加尾数，最后只做一次除以10的幂：有效数字不超过15位时尾数和10的幂都能精确表示，结果与atof完全一致
+double gps_parse_decimal(const char* str) {
+    const char* end = str + GPS_NUMBER_MAX_CHARS;
+    while (str < end && isspace((unsigned char) *str)) {
+        str++;
+    }
+    int negative = 0;
+    if (str < end && (*str == '-' || *str == '+')) {
+        negative = *str == '-';
+        str++;
+    }
+
+    const char* digits = str;
+    int64_t mantissa = 0;
+    int exponent = 0;
+    while (str < end && isdigit((unsigned char) *str)) {
+        if (mantissa < DECIMAL_MAX_MANTISSA) {
+            mantissa = mantissa * 10 + (*str - '0');
+        } else {
+            exponent++;
+        }
+        str++;
+    }
+    if (str < end && *str == '.') {
+        str++;
+        while (str < end && isdigit((unsigned char) *str)) {
+            if (mantissa < DECIMAL_MAX_MANTISSA) {
+                mantissa = mantissa * 10 + (*str - '0');
+                exponent--;
+            }
+            str++;
+        }
+    }
+    if (str == digits || (str == digits + 1 && *digits == '.')) {
+        return 0.0; // 没有数字，和atof一样返回+0
+    }
+
+    double value = (double) mantissa;
+    if (exponent < 0) {
+        value /= pow10_table[-exponent]; // 尾数最多18位，exponent在-18到6之间
+    } else if (exponent > 0) {
+        value *= pow10_table[exponent];
+    }
+    return negative ? -value : value;
+}
+#endif
+
+#if GPS_INTEGER_ONLY
+#define FIXED_INT_LIMIT 100000000000LL // 整数部分超过这个值就不再累加，防止乘上小数位后溢出
+
+// 把十进制文本解析成 值×10^digits，多出的小数位四舍五入；和atof一样跳过前导空白，遇到非数字停止
+// 最多读GPS_NUMBER_MAX_CHARS个字符
+int64_t gps_parse_fixed64(const char* str, int digits) {
+    const char* end = str + GPS_NUMBER_MAX_CHARS;
+    while (str < end && isspace((unsigned char) *str)) {
+        str++;
+    }
+    int negative = 0;
+    if (str < end && (*str == '-' || *str == '+')) {
+        negative = *str == '-';
+        str++;
+    }
+
+    int64_t value = 0;
+    while (str < end && isdigit((unsigned char) *str)) {
+        if (value < FIXED_INT_LIMIT) {
+            value = value * 10 + (*str - '0');
+        }
+        str++;
+    }
+
+    int remaining = digits;
+    if (str < end && *str == '.') {
+        str++;
+        while (remaining > 0 && str < end && isdigit((unsigned char) *str)) {
+            value = value * 10 + (*str - '0');
+            remaining--;
+            str++;
+        }
+        if (remaining == 0 && str < end && *str >= '5' && *str <= '9') {
+            value++;
+        }
+    }
+    while (remaining-- > 0) {
+        value *= 10;
+    }
+    return negative ? -value : value;
+}
+
+int32_t gps_parse_fixed(const char* str, int digits) {
+    int64_t value = gps_parse_fixed64(str, digits);
+    if (value > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (value < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t) value;
+}
+
+// cos(0..90度)，Q15
+static const uint16_t cos_table[91] = {
+        32768, 32763, 32748, 32723, 32688, 32643, 32588, 32524, 32449, 32365,
+        32270, 32166, 32052, 31928, 31795, 31651, 31499, 31336, 31164, 30983,
+        30792, 30592, 30382, 30163, 29935, 29698, 29452, 29197, 28932, 28660,
+        28378, 28088, 27789, 27482, 27166, 26842, 26510, 26170, 25822, 25466,
+        25102, 24730, 24351, 23965, 23571, 23170, 22763, 22348, 21926, 21498,
+        21063, 20622, 20174, 19720, 19261, 18795, 18324, 17847, 17364, 16877,
+        16384, 15886, 15384, 14876, 14365, 13848, 13328, 12803, 12275, 11743,
+        11207, 10668, 10126, 9580, 9032, 8481, 7927, 7371, 6813, 6252,
+        5690, 5126, 4560, 3993, 3425, 2856, 2286, 1715, 1144, 572,
+        0,
+};
+
+// 纬度范围内（-90~90度）的cos，Q15，按1度查表线性插值，误差小于5e-5
+int32_t gps_cos_q15(gps_degree_t angle) {
+    uint32_t a = (uint32_t) (angle < 0 ? -(int64_t) angle : angle);
+    if (a >= 90u * GPS_DEGREE_SCALE) {
+        return 0;
+    }
+    uint32_t index = a / GPS_DEGREE_SCALE;
+    uint32_t fraction = a % GPS_DEGREE_SCALE;
+    int32_t low = cos_table[index];
+    int32_t high = cos_table[index + 1];
+    return low - (int32_t) ((int64_t) (low - high) * fraction / GPS_DEGREE_SCALE);
+}
+
+// 64位整数平方根（向下取整），逐位试商
+uint32_t gps_isqrt64(uint64_t value) {
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t) result;
+}
+#endif
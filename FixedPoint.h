@@ -0,0 +1,115 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_FIXEDPOINT_H
+#define NMEA0183_FIXEDPOINT_H
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include "GPSConfig.h"
+
+// 解析结果的数值类型
+// 默认都是double；GPS_INTEGER_ONLY=1 时全部存为定标整数，解析路径上没有任何浮点运算，适合没有FPU的MCU
+// 解析代码统一用下面的宏，两种模式共用一份代码：
+//   GPS_PARSE(str, KIND)     把字段文本解析成对应类型
+//   GPS_CONST(value, KIND)   把范围检查用的常量换成对应类型（编译期计算）
+//   GPS_TO_DOUBLE(v, KIND)   上层浮点模块取值时换算回原单位
+// 整数模式和有界解析模式（GPS_BOUNDED_PARSE）下数字由本文件的函数逐位解析，不调用atof/atoi/sscanf，
+// 每个函数最多读 GPS_NUMBER_MAX_CHARS 个字符，耗时有上界
+
+#if GPS_INTEGER_ONLY
+typedef int32_t gps_degree_t;   // 1e-7 度
+typedef int32_t gps_minute_t;   // 1e-7 分（度分格式里的分钟部分）
+typedef int64_t gps_dm_t;       // 原始度分值 dddmm.mmmmmmm，乘以1e7
+typedef int32_t gps_tod_t;      // 当天的毫秒数
+typedef int32_t gps_second_t;   // 毫秒
+typedef int32_t gps_speed_t;    // 0.001 节 或 0.001 公里/小时
+typedef int32_t gps_angle_t;    // 0.01 度（航向、磁偏角）
+typedef int32_t gps_dop_t;      // 0.01
+typedef int32_t gps_meter_t;    // 毫米
+typedef int32_t gps_distance_t; // 厘米，无效时为-1
+
+#define GPS_DEGREE_DIGITS 7
+#define GPS_MINUTE_DIGITS 7
+#define GPS_SECOND_DIGITS 3
+#define GPS_SPEED_DIGITS 3
+#define GPS_ANGLE_DIGITS 2
+#define GPS_DOP_DIGITS 2
+#define GPS_METER_DIGITS 3
+#define GPS_DISTANCE_DIGITS 2
+
+#define GPS_DEGREE_SCALE 10000000
+#define GPS_MINUTE_SCALE 10000000
+#define GPS_SECOND_SCALE 1000
+#define GPS_TOD_SCALE 1000
+#define GPS_SPEED_SCALE 1000
+#define GPS_ANGLE_SCALE 100
+#define GPS_DOP_SCALE 100
+#define GPS_METER_SCALE 1000
+#define GPS_DISTANCE_SCALE 100
+
+#define GPS_NAN INT32_MIN // 代替NAN表示“没有数据”
+
+#define GPS_PARSE(str, KIND) gps_parse_fixed((str), GPS_##KIND##_DIGITS)
+#define GPS_CONST(value, KIND) ((int32_t) ((value) * GPS_##KIND##_SCALE + ((value) < 0 ? -0.5 : 0.5)))
+#define GPS_TO_DOUBLE(v, KIND) ((double) (v) / GPS_##KIND##_SCALE)
+
+#define GPS_PARSE_DM(str) gps_parse_fixed64((str), GPS_MINUTE_DIGITS)
+#define GPS_DM_DEGREES(dm) ((gps_degree_t) ((dm) / (100LL * GPS_MINUTE_SCALE)) * GPS_DEGREE_SCALE)
+#define GPS_DM_MINUTES(dm) ((gps_minute_t) ((dm) % (100LL * GPS_MINUTE_SCALE)))
+#define GPS_UTC_TIME(hour, minute, second) ((gps_tod_t) (((hour) * 3600 + (minute) * 60) * 1000 + (second)))
+
+int32_t gps_parse_fixed(const char* str, int digits);
+int64_t gps_parse_fixed64(const char* str, int digits);
+int32_t gps_cos_q15(gps_degree_t angle);
+uint32_t gps_isqrt64(uint64_t value);
+#else
+typedef double gps_degree_t;    // 度
+typedef double gps_minute_t;    // 分
+typedef double gps_dm_t;        // 原始度分值 dddmm.mmmm
+typedef double gps_tod_t;       // 小时+分钟/60+秒/3600
+typedef double gps_second_t;    // 秒
+typedef double gps_speed_t;     // 节 或 公里/小时
+typedef double gps_angle_t;     // 度
+typedef double gps_dop_t;
+typedef double gps_meter_t;     // 米
+typedef double gps_distance_t;  // 米，无效时为NAN
+
+#define GPS_NAN NAN
+
+#define GPS_CONST(value, KIND) (value)
+#define GPS_TO_DOUBLE(v, KIND) ((double) (v))
+
+#define GPS_DM_DEGREES(dm) ((int) ((dm) / 100))
+#define GPS_DM_MINUTES(dm) ((dm) - GPS_DM_DEGREES(dm) * 100)
+#define GPS_UTC_TIME(hour, minute, second) ((hour) + (minute) / 60.0 + (second) / 3600.0)
+
+#if GPS_BOUNDED_PARSE
+#define GPS_PARSE(str, KIND) gps_parse_decimal(str)
+#define GPS_PARSE_DM(str) gps_parse_decimal(str)
+
+double gps_parse_decimal(const char* str);
+#else
+#define GPS_PARSE(str, KIND) atof(str)
+#define GPS_PARSE_DM(str) atof(str)
+#endif
+#endif
+
+#if GPS_INTEGER_ONLY || GPS_BOUNDED_PARSE
+#define GPS_NUMBER_MAX_CHARS 24 // 单个数字字段最多读多少个字符
+#define GPS_PARSE_INT(str) gps_parse_int(str)
+#define GPS_PARSE_HMS(str, hour, minute, second) gps_parse_hms((str), (hour), (minute), (second))
+#define GPS_PARSE_DMY(str, day, month, year) gps_parse_dmy((str), (day), (month), (year))
+
+int gps_parse_int(const char* str);
+int gps_parse_hms(const char* str, int* hour, int* minute, gps_second_t* second);
+int gps_parse_dmy(const char* str, int* day, int* month, int* year);
+#else
+#define GPS_PARSE_INT(str) atoi(str)
+#define GPS_PARSE_HMS(str, hour, minute, second) sscanf((str), "%2d%2d%lf", (hour), (minute), (second))
+#define GPS_PARSE_DMY(str, day, month, year) sscanf((str), "%2d%2d%2d", (day), (month), (year))
+#endif
+
+#endif // NMEA0183_FIXEDPOINT_H
@@ -0,0 +1,146 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_GPSCONFIG_H
+#define NMEA0183_GPSCONFIG_H
+
+// 编译期功能裁剪，全部默认打开
+// 可以逐个用 -DGPS_ENABLE_xxx=0 关闭，也可以用 -DGPS_USER_CONFIG_FILE=\"my_config.h\" 集中配置
+// 关掉的语句类型不编译解析函数，gps_data_t 里对应的成员也会去掉，收到这类语句按REJECTED计
+
+#ifdef GPS_USER_CONFIG_FILE
+#include GPS_USER_CONFIG_FILE
+#endif
+
+// 小型接收机预设：只解析GGA和RMC，不带UBX、打印、距离计算、卫星表和运行时统计
+#ifndef GPS_CONFIG_MINIMAL
+#define GPS_CONFIG_MINIMAL 0
+#endif
+
+#if GPS_CONFIG_MINIMAL
+#ifndef GPS_ENABLE_SATELLITES
+#define GPS_ENABLE_SATELLITES 0
+#endif
+#ifndef GPS_ENABLE_GLL
+#define GPS_ENABLE_GLL 0
+#endif
+#ifndef GPS_ENABLE_VTG
+#define GPS_ENABLE_VTG 0
+#endif
+#ifndef GPS_ENABLE_ZDA
+#define GPS_ENABLE_ZDA 0
+#endif
+#ifndef GPS_ENABLE_PRINT
+#define GPS_ENABLE_PRINT 0
+#endif
+#ifndef GPS_ENABLE_DISTANCE
+#define GPS_ENABLE_DISTANCE 0
+#endif
+#ifndef GPS_ENABLE_METRICS
+#define GPS_ENABLE_METRICS 0
+#endif
+#ifndef GPS_ENABLE_UBX
+#define GPS_ENABLE_UBX 0
+#endif
+// 共享内存、授时、等待通知依赖操作系统，裁剪版一律不要
+#ifndef GPS_ENABLE_SHM
+#define GPS_ENABLE_SHM 0
+#endif
+#ifndef GPS_ENABLE_TIME_SERVICE
+#define GPS_ENABLE_TIME_SERVICE 0
+#endif
+#ifndef GPS_ENABLE_NOTIFY_WAIT
+#define GPS_ENABLE_NOTIFY_WAIT 0
+#endif
+#ifndef RING_SIZE
+#define RING_SIZE 512
+#endif
+#ifndef BUFF_SIZE
+#define BUFF_SIZE 256
+#endif
+#endif
+
+// 语句类型
+#ifndef GPS_ENABLE_GGA
+#define GPS_ENABLE_GGA 1
+#endif
+#ifndef GPS_ENABLE_RMC
+#define GPS_ENABLE_RMC 1
+#endif
+#ifndef GPS_ENABLE_GLL
+#define GPS_ENABLE_GLL 1
+#endif
+#ifndef GPS_ENABLE_VTG
+#define GPS_ENABLE_VTG 1
+#endif
+#ifndef GPS_ENABLE_ZDA
+#define GPS_ENABLE_ZDA 1
+#endif
+
+// u-blox UBX二进制协议（NAV-PVT/NAV-DOP/NAV-SAT），见UbxSolve.h
+#ifndef GPS_ENABLE_UBX
+#define GPS_ENABLE_UBX 1
+#endif
+
+// 卫星表（GSA/GSV），关掉后两种语句默认也一起关掉
+#ifndef GPS_ENABLE_SATELLITES
+#define GPS_ENABLE_SATELLITES 1
+#endif
+#ifndef GPS_ENABLE_GSA
+#define GPS_ENABLE_GSA GPS_ENABLE_SATELLITES
+#endif
+#ifndef GPS_ENABLE_GSV
+#define GPS_ENABLE_GSV GPS_ENABLE_SATELLITES
+#endif
+#if (GPS_ENABLE_GSA || GPS_ENABLE_GSV) && !GPS_ENABLE_SATELLITES
+#error "GPS_ENABLE_GSA/GPS_ENABLE_GSV need GPS_ENABLE_SATELLITES"
+#endif
+
+// 整数模式：解析结果全部存为定标整数，不用double也不链接libm，见FixedPoint.h
+#ifndef GPS_INTEGER_ONLY
+#define GPS_INTEGER_ONLY 0
+#endif
+
+// 有界解析模式：不调用atof/atoi/sscanf这类耗时不定的库函数，语句长度上限缩小到NMEA_MAX_SENTENCE，
+// 每条语句的栈用量和执行时间都有上界，可以用Wcet.h里的工具测量最坏情况
+// 栈用量（gcc -Os -fstack-usage，x86-64）：最深的parse_gprmc/parse_gpgga/parse_gpgsv_single各304字节，
+// 加上校验和与数字解析一条语句最多约450字节，从solve_once开始算约1.1KB
+#ifndef GPS_BOUNDED_PARSE
+#define GPS_BOUNDED_PARSE 0
+#endif
+
+// 单条语句（$之后、*之前）的最大长度，也是各解析函数栈上复制缓冲区的大小
+// NMEA 0183规定整条语句不超过82个字符
+#ifndef NMEA_MAX_SENTENCE
+#if GPS_BOUNDED_PARSE
+#define NMEA_MAX_SENTENCE 96
+#else
+#define NMEA_MAX_SENTENCE 256
+#endif
+#endif
+
+// RMC两位年份的分界：不小于这个值的是19xx，否则是20xx
+#ifndef NMEA_YEAR_PIVOT
+#define NMEA_YEAR_PIVOT 80
+#endif
+
+// 解析缓存：和上次内容相同（带时间的语句除时间字段外相同）的语句直接沿用上次的解析结果，见ParseCache.h
+#ifndef GPS_ENABLE_PARSE_CACHE
+#define GPS_ENABLE_PARSE_CACHE 0
+#endif
+
+// print_xxx_info 系列（依赖printf的%f，整数模式下不可用）
+#ifndef GPS_ENABLE_PRINT
+#define GPS_ENABLE_PRINT (!GPS_INTEGER_ONLY)
+#endif
+#if GPS_ENABLE_PRINT && GPS_INTEGER_ONLY
+#error "GPS_ENABLE_PRINT is not available with GPS_INTEGER_ONLY"
+#endif
+
+// calculate_distance（浮点模式用libm的三角函数，整数模式用查表近似）
+#ifndef GPS_ENABLE_DISTANCE
+#define GPS_ENABLE_DISTANCE 1
+#endif
+
+#endif // NMEA0183_GPSCONFIG_H
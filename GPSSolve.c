@@ -3,59 +3,392 @@
 //
 
 #include "GPSSolve.h"
-#define BUFF_SIZE 1024
+#ifndef BUFF_SIZE
+#define BUFF_SIZE 2048 //解析缓冲区，要能放下至少一条完整语句或一帧二进制数据（RTCM3最长1029字节）
+#endif
+#define MAX_EPOCH_SENTENCES 64 //每个历元最多记录多少条语句的到达时间
+#define GPS_ARRIVAL_MARKS (GPS_ENABLE_METRICS||GPS_ENABLE_TIME_SERVICE) //统计和授时都要用到达时间
+static char ring_storage[RING_SIZE];
+static gps_ring_t sentence_ring = GPS_RING_INITIALIZER(ring_storage, RING_SIZE, GPS_RING_DROP_NEWEST);
 static char sovle_buff[BUFF_SIZE]={0};
-static uint32_t buff_pointer=0;
+static uint32_t buff_pointer=0;//上次没解析完的半条语句长度
+static size_t buff_offset=0;//sovle_buff[0]在整个数据流中的位置
 static gps_data_t gps_data_preview={0};
 static gps_data_t gps_data={0};
+static gps_day_cache_t epoch_day={0};//只在跨天时重新计算日期
+static gps_frame_handler_t frame_handler=0;
+static void *frame_handler_user=0;
+static gps_sentence_handler_t sentence_handler=0;
+static void *sentence_handler_user=0;
+#if GPS_ENABLE_SHM
+static gps_shm_t *shm_publisher=0;
+#endif
+#if GPS_ENABLE_TIME_SERVICE
+static gps_time_service_t *time_service=0;
+#endif
+
+#if GPS_ARRIVAL_MARKS
+//到达时间标记：生产者每次写入后记录(写到的位置, 时刻)，解析时据此得到每条语句第一个字节的到达时间
+typedef struct {
+    size_t end;
+    uint64_t ns;
+} arrival_mark_t;
+static char mark_storage[64*sizeof(arrival_mark_t)];
+static gps_ring_t mark_ring = GPS_RING_INITIALIZER(mark_storage, sizeof(mark_storage), GPS_RING_DROP_NEWEST);
+static arrival_mark_t current_mark;
+static int has_mark=0;
+#endif
+
+#if GPS_ENABLE_PARSE_CACHE
+//每个解析结果槽位一个缓存记录，和gps_data_preview里的成员一一对应
+static struct {
+    gps_parse_memo_t gga,gll,rmc,vtg,zda;
+    gps_parse_memo_t gsa[MAX_KIND_OF_SATELLITE];
+    gps_parse_memo_t gsv[MAX_KIND_OF_SATELLITE][EACH_KIND_OF_SATELLITE];
+} parse_memo;
+//内容没变就沿用槽位里的结果（带时间的语句只刷新时间），否则解析并记下这条语句
+#define MEMO_PARSE_IMPL(memo,time_field,call,refresh) do{ \
+        gps_memo_key_t key; \
+        int hit=gps_memo_lookup(&(memo),token,(time_field),&key); \
+        if (hit==1) { \
+            refresh; \
+            ret=0; \
+            memo_hit=1; \
+        }else { \
+            ret=(call); \
+            if (ret==0&&hit==0)gps_memo_store(&(memo),&key); \
+            else gps_memo_invalidate(&(memo)); \
+        } \
+    }while(0)
+#define MEMO_PARSE(memo,call) MEMO_PARSE_IMPL(memo,0,call,(void)0)
+#define MEMO_PARSE_TIMED(memo,out,time_field,check_range,call) MEMO_PARSE_IMPL(memo,time_field,call, \
+        (out).has_time=gps_memo_refresh_time(key.time_str,(check_range),&(out).hour,&(out).minute,&(out).second,&(out).utc_time))
+#else
+#define MEMO_PARSE(memo,call) (ret=(call))
+#define MEMO_PARSE_TIMED(memo,out,time_field,check_range,call) (ret=(call))
+#endif
+
+#if GPS_ENABLE_TRACE
+static const char *const parse_span_names[GPS_SENTENCE_TYPE_COUNT]={
+    "parse_gpgga","parse_gpgll","parse_gpgsa","gsv_assembly","parse_gprmc","parse_gpvtg","parse_gpzda","txt","other"};
+#endif
+
+//一次solve_once内跨多个分块的解析状态
+typedef struct {
+    uint32_t gsa_pointer;
+    char last_gsv_system[2];
+    int gsv_pointer;
+    uint32_t gsv_child_pointer;
+#if GPS_ENABLE_METRICS
+    uint64_t arrivals[MAX_EPOCH_SENTENCES];
+    uint64_t parsed[MAX_EPOCH_SENTENCES];//对应语句解析完的时刻
+    uint32_t arrival_count;
+    int timed;//本次有带时间的语句，历元的utc_ns是新的
+#endif
+} solve_state_t;
+
 gps_data_t* get_gps_data() {
     return  &gps_data;
 }
+static void mark_arrival() {
+#if GPS_ARRIVAL_MARKS
+#if !GPS_ENABLE_METRICS
+    if (!time_service)return;//只有授时用到达时间，没打开就不记
+#endif
+    arrival_mark_t mark={gps_ring_head(&sentence_ring),gps_monotonic_ns()};
+    gps_ring_write(&mark_ring,(const char*)&mark,sizeof(mark));//标记队列满了就不记，到达时间会按下一个标记算
+#endif
+}
 void add_sentence(char *sentence) {
     uint32_t len = strlen(sentence);
-    if (buff_pointer>=BUFF_SIZE||len>BUFF_SIZE-buff_pointer)return;
-    strcpy(sovle_buff+buff_pointer,sentence);
-    buff_pointer+=len+1;
-    sovle_buff[buff_pointer-1]='\n';
+    //整条语句连同换行一起写入，放不下就整条丢弃，不会留下半条
+    if (gps_ring_reserve(&sentence_ring,len+1)!=0)return;
+    gps_ring_put(&sentence_ring,0,sentence,len);
+    gps_ring_put(&sentence_ring,len,"\n",1);
+    gps_ring_commit(&sentence_ring,len+1);
+    mark_arrival();
 }
-void solve_once() {
-    char *token=0;
-    char *rest=sovle_buff;
-    uint32_t gsa_pointer=0;
-
-    char last_gsv_system[2]="00";
-    int gsv_pointer=-1;
-    uint32_t gsv_child_pointer=0;
-    while ((token=strtok_my(rest,"\n",&rest))) {
-        if (strncmp(token+3,"GGA,",4)==0) {
-            parse_gpgga(token,&gps_data_preview.gga);
-        }else if (strncmp(token+3,"GLL,",4)==0) {
-            parse_gpgll(token,&gps_data_preview.gll);
-        }else if (strncmp(token+3,"GSA,",4)==0) {
-            if (gsa_pointer>=MAX_KIND_OF_SATELLITE)continue;
-            parse_gpgsa(token,&gps_data_preview.satellites.gsa[gsa_pointer]);
-            gsa_pointer++;
-        }else if (strncmp(token+3,"GSV,",4)==0) {
-            if (strncmp(token+1,last_gsv_system,2)==0) {
-                gsv_child_pointer++;
+uint32_t add_bytes(const char *data, uint32_t len) {
+    uint32_t written=gps_ring_write(&sentence_ring,data,len);
+    if (written>0)mark_arrival();
+    return written;
+}
+gps_ring_t *get_input_ring() {
+    return &sentence_ring;
+}
+void mark_input_arrival() {
+    mark_arrival();
+}
+void set_overflow_policy(int policy) {
+    gps_ring_set_policy(&sentence_ring,policy);
+}
+void get_ring_stats(gps_ring_stats_t *stats) {
+    gps_ring_get_stats(&sentence_ring,stats);
+}
+void set_frame_handler(gps_frame_handler_t handler,void *user) {
+    frame_handler=handler;
+    frame_handler_user=user;
+}
+#if GPS_ENABLE_SHM
+void set_shm_publisher(gps_shm_t *shm) {
+    shm_publisher=shm;
+}
+#endif
+void set_sentence_handler(gps_sentence_handler_t handler,void *user) {
+    sentence_handler=handler;
+    sentence_handler_user=user;
+}
+#if GPS_ENABLE_TIME_SERVICE
+void set_time_service(gps_time_service_t *service) {
+    time_service=service;
+}
+#endif
+void get_metrics_snapshot(gps_metrics_snapshot_t *snapshot) {
+    gps_metrics_snapshot(snapshot);
+    gps_ring_get_stats(&sentence_ring,&snapshot->ring);
+}
+#if GPS_ARRIVAL_MARKS
+//数据流中offset处字节的到达时刻，未知时返回0；queued是同一次写入里从offset到末尾的字节数
+static uint64_t arrival_of(size_t offset,uint32_t *queued) {
+    while (!has_mark||(ptrdiff_t)(current_mark.end-offset)<=0) {
+        if (gps_ring_read(&mark_ring,(char*)&current_mark,sizeof(current_mark))!=sizeof(current_mark)) {
+            has_mark=0;
+            return 0;
+        }
+        has_mark=1;
+    }
+    *queued=(uint32_t)(current_mark.end-offset);
+    return current_mark.ns;
+}
+#endif
+//返回语句处理结果GPS_OUTCOME_*
+static int solve_sentence(char *token,int type,solve_state_t *state) {
+    (void)state; // GSA和GSV都关掉时用不到
+    int ret=0;
+    int memo_hit=0;
+    GPS_TRACE_BEGIN(trace_parse);
+    switch (type) {
+#if GPS_ENABLE_GGA
+        case GPS_SENTENCE_GGA:
+            MEMO_PARSE_TIMED(parse_memo.gga,gps_data_preview.gga,1,1,parse_gpgga(token,&gps_data_preview.gga));
+            break;
+#endif
+#if GPS_ENABLE_GLL
+        case GPS_SENTENCE_GLL:
+            MEMO_PARSE_TIMED(parse_memo.gll,gps_data_preview.gll,5,0,parse_gpgll(token,&gps_data_preview.gll));
+            break;
+#endif
+#if GPS_ENABLE_GSA
+        case GPS_SENTENCE_GSA:
+            if (state->gsa_pointer>=MAX_KIND_OF_SATELLITE)return GPS_OUTCOME_DROPPED;
+            MEMO_PARSE(parse_memo.gsa[state->gsa_pointer],parse_gpgsa(token,&gps_data_preview.satellites.gsa[state->gsa_pointer]));
+            state->gsa_pointer++;
+            break;
+#endif
+#if GPS_ENABLE_GSV
+        case GPS_SENTENCE_GSV:
+            if (strncmp(token+1,state->last_gsv_system,2)==0) {
+                state->gsv_child_pointer++;
             }else {
-                gsv_pointer++;
-                gsv_child_pointer=0;
+                state->gsv_pointer++;
+                state->gsv_child_pointer=0;
             }
-            parse_gpgsv_single(token,&gps_data_preview.satellites.gsv[gsv_pointer][gsv_child_pointer]);
-            strncpy(last_gsv_system,token+1,2);
-        }else if (strncmp(token+3,"RMC,",4)==0) {
-            parse_gprmc(token,&gps_data_preview.rmc);
-        }else if (strncmp(token+3,"VTG,",4)==0) {
-            parse_gpvtg(token,&gps_data_preview.vtg);
-        }else if (strncmp(token+3,"ZDA,",4)==0) {
-            parse_gpzda(token,&gps_data_preview.zda);
-        }else if (strncmp(token+3,"TXT,",4)==0) {
+            memcpy(state->last_gsv_system,token+1,2);
+            if (state->gsv_pointer>=MAX_KIND_OF_SATELLITE||state->gsv_child_pointer>=EACH_KIND_OF_SATELLITE)return GPS_OUTCOME_DROPPED;
+            MEMO_PARSE(parse_memo.gsv[state->gsv_pointer][state->gsv_child_pointer],
+                       parse_gpgsv_single(token,&gps_data_preview.satellites.gsv[state->gsv_pointer][state->gsv_child_pointer]));
+            break;
+#endif
+#if GPS_ENABLE_RMC
+        case GPS_SENTENCE_RMC:
+            MEMO_PARSE_TIMED(parse_memo.rmc,gps_data_preview.rmc,1,1,parse_gprmc(token,&gps_data_preview.rmc));
+            break;
+#endif
+#if GPS_ENABLE_VTG
+        case GPS_SENTENCE_VTG:
+            MEMO_PARSE(parse_memo.vtg,parse_gpvtg(token,&gps_data_preview.vtg));
+            break;
+#endif
+#if GPS_ENABLE_ZDA
+        case GPS_SENTENCE_ZDA:
+            MEMO_PARSE_TIMED(parse_memo.zda,gps_data_preview.zda,1,1,parse_gpzda(token,&gps_data_preview.zda));
+            break;
+#endif
+        case GPS_SENTENCE_TXT:
             //这个在我这个模块好像就是每帧的结尾信息
+            break;
+        default:
+            //未编译进来的语句类型也走这里
+            return GPS_OUTCOME_REJECTED;
+    }
+    GPS_TRACE_END(trace_parse,parse_span_names[type]);
+#if GPS_ENABLE_METRICS
+    if (memo_hit)gps_metrics_add_cache_hit();
+#endif
+    (void)memo_hit;
+    if (ret==-3||ret==-4)return GPS_OUTCOME_TRUNCATED;
+    return ret==0?GPS_OUTCOME_PARSED:GPS_OUTCOME_REJECTED;
+}
+static void solve_line(char *token,uint32_t len,size_t offset,solve_state_t *state) {
+    GPS_TRACE_BEGIN(trace_dispatch);
+    int type=gps_sentence_type_index(token);
+    int outcome;
+    int ret=nmea_verify_checksum(token);
+    if (ret!=0) {
+        outcome=ret==-3?GPS_OUTCOME_TRUNCATED:GPS_OUTCOME_CHECKSUM_FAILED;
+    }else {
+        if (sentence_handler)sentence_handler(token,len,sentence_handler_user);
+#if GPS_ENABLE_METRICS
+        uint64_t start=gps_monotonic_ns();
+        outcome=solve_sentence(token,type,state);
+        uint64_t parsed=gps_monotonic_ns();
+        gps_metrics_observe_parse(parsed-start);
+#else
+        outcome=solve_sentence(token,type,state);
+#endif
+#if GPS_ARRIVAL_MARKS
+        uint32_t queued=0;
+        uint64_t arrival=arrival_of(offset,&queued);
+#endif
+#if GPS_ENABLE_METRICS
+        if (arrival!=0)gps_metrics_observe_stage(GPS_STAGE_QUEUE,(int64_t)(start-arrival));
+        if (outcome==GPS_OUTCOME_PARSED&&arrival!=0&&state->arrival_count<MAX_EPOCH_SENTENCES) {
+            state->arrivals[state->arrival_count]=arrival;
+            state->parsed[state->arrival_count++]=parsed;
+        }
+        if (outcome==GPS_OUTCOME_PARSED&&(type==GPS_SENTENCE_GGA||type==GPS_SENTENCE_RMC||type==GPS_SENTENCE_ZDA)) {
+            state->timed=1;
+        }
+#endif
+#if GPS_ENABLE_TIME_SERVICE
+        if (time_service&&outcome==GPS_OUTCOME_PARSED&&arrival!=0) {
+            gps_time_service_observe(time_service,type,&gps_data_preview,arrival,queued);
+        }
+#endif
+    }
+#if GPS_ENABLE_METRICS
+    gps_metrics_count(gps_talker_index(token),type,outcome);
+#else
+    (void)outcome;
+#endif
+#if !GPS_ARRIVAL_MARKS
+    (void)offset;
+#endif
+    GPS_TRACE_END(trace_dispatch,"dispatch");
+}
+#if GPS_ENABLE_UBX
+//解析一帧UBX到当前历元，和solve_once在同一个线程调用，结果随下一次solve_once发布
+int solve_ubx_frame(const uint8_t *frame, uint32_t len) {
+    GPS_TRACE_BEGIN(trace_ubx);
+    int ret=parse_ubx_frame(frame,len,&gps_data_preview);
+#if GPS_ENABLE_PARSE_CACHE
+    memset(&parse_memo,0,sizeof(parse_memo));//槽位内容被UBX改写了，缓存全部作废
+#endif
+    GPS_TRACE_END(trace_ubx,"parse_ubx");
+    return ret;
+}
+#endif
+//处理分出来的一帧，offset是它在整个数据流中的位置
+static void solve_frame(gps_frame_t *frame,size_t offset,solve_state_t *state) {
+#if GPS_ENABLE_METRICS
+    gps_metrics_count_frame(frame->protocol,1);
+#endif
+    if (frame->protocol==GPS_PROTOCOL_NMEA) {
+        char *token=(char*)frame->data;
+        token[frame->length]='\0';//行尾的\r或\n
+        if (frame->length>=7)solve_line(token,frame->length,offset,state);
+        return;
+    }
+#if GPS_ENABLE_UBX
+    if (frame->protocol==GPS_PROTOCOL_UBX)solve_ubx_frame(frame->data,frame->length);
+#endif
+    if (frame_handler)frame_handler(frame,frame_handler_user);
+}
+void solve_once() {
+    GPS_TRACE_BEGIN(trace_solve);
+    solve_state_t state={.last_gsv_system={'0','0'},.gsv_pointer=-1};
+    //把环形缓冲区里的数据分块取出来，只处理完整的帧，剩下的半帧留到下一块/下一次
+    uint32_t len;
+    size_t position;
+    uint32_t frames=0;//本次解析的完整帧数，没有新数据就不通知
+    for (;;) {
+        GPS_TRACE_BEGIN(trace_framing);
+        len=gps_ring_read_from(&sentence_ring,sovle_buff+buff_pointer,BUFF_SIZE-1-buff_pointer,&position);
+        GPS_TRACE_END(trace_framing,"framing");
+        if (len==0)break;
+        if (buff_pointer>0&&position!=buff_offset+buff_pointer) {
+            //中间有数据被溢出策略丢掉了，前面的半帧接不上，作废
+#if GPS_ENABLE_METRICS
+            gps_metrics_add_unframed(buff_pointer);
+#endif
+            memmove(sovle_buff,sovle_buff+buff_pointer,len);
+            buff_pointer=0;
+        }
+        buff_offset=position-buff_pointer;
+        buff_pointer+=len;
+        uint32_t consumed=0;
+        for (;;) {
+            gps_frame_t frame;
+            int ret=gps_demux_next((const uint8_t*)sovle_buff+consumed,buff_pointer-consumed,&frame);
+#if GPS_ENABLE_METRICS
+            if (frame.skipped>0)gps_metrics_add_unframed(frame.skipped);
+#endif
+            if (ret==GPS_DEMUX_FRAME) {
+                solve_frame(&frame,buff_offset+((const char*)frame.data-sovle_buff),&state);
+                frames++;
+            }else if (ret==GPS_DEMUX_BAD_CHECKSUM) {
+#if GPS_ENABLE_METRICS
+                gps_metrics_count_frame(frame.protocol,0);
+#endif
+            }else if (buff_pointer-consumed-frame.consumed>=BUFF_SIZE-1) {
+                //缓冲区满了还凑不成一帧，说明开头的同步字是假的，跳过它接着找
+#if GPS_ENABLE_METRICS
+                gps_metrics_add_unframed(1);
+#endif
+                frame.consumed++;
+            }else {
+                consumed+=frame.consumed;
+                break;
+            }
+            consumed+=frame.consumed;
         }
+        uint32_t remain=buff_pointer-consumed;
+        memmove(sovle_buff,sovle_buff+consumed,remain);
+        buff_offset+=consumed;
+        buff_pointer=remain;
     }
     //清理工作
+    GPS_TRACE_BEGIN(trace_publish);
+    gps_epoch_time_update(&gps_data_preview,&epoch_day);
     memcpy(&gps_data,&gps_data_preview,sizeof(gps_data_t));
-    memset(sovle_buff,0,buff_pointer);
-    buff_pointer=0;
-}
\ No newline at end of file
+#if GPS_ENABLE_SHM
+    if (shm_publisher) {
+        gps_shm_publish(shm_publisher,&gps_data,gps_monotonic_ns());
+    }
+#endif
+    GPS_TRACE_END(trace_publish,"publish");
+#if GPS_ENABLE_METRICS
+    //发布完成的时刻要在通知之前取，回调的耗时不能算进发布等待/历元/端到端
+    uint64_t now=gps_monotonic_ns();
+    int64_t real_now=state.timed&&gps_data.has_utc_ns?gps_realtime_ns():0;
+#endif
+    if (frames>0)gps_notify_epoch(&gps_data);
+#if GPS_ENABLE_METRICS
+    uint64_t first=UINT64_MAX;
+    for (uint32_t i=0;i<state.arrival_count;i++) {
+        gps_metrics_observe_publish_age(now-state.arrivals[i]);
+        gps_metrics_observe_stage(GPS_STAGE_PUBLISH_WAIT,(int64_t)(now-state.parsed[i]));
+        if (state.arrivals[i]<first)first=state.arrivals[i];
+    }
+    if (state.arrival_count>0) {
+        gps_metrics_observe_stage(GPS_STAGE_EPOCH,(int64_t)(now-first));
+        if (state.timed&&gps_data.has_utc_ns) {
+            //单调时钟换算到系统时间再和接收机的UTC时间标签比较
+            gps_metrics_observe_stage(GPS_STAGE_RECEIVER,real_now-(int64_t)(now-first)-gps_data.utc_ns);
+            gps_metrics_observe_stage(GPS_STAGE_END_TO_END,real_now-gps_data.utc_ns);
+        }
+    }
+    gps_metrics_add_epoch();
+#endif
+    GPS_TRACE_END(trace_solve,"solve_once");
+}
@@ -5,7 +5,44 @@
 #ifndef NMEA0183_GPSSOLVE_H
 #define NMEA0183_GPSSOLVE_H
 #include "NMEA0183Solve.h"
+#include "RingBuffer.h"
+#include "Metrics.h"
+#include "Trace.h"
+#include "ParseCache.h"
+#include "UbxSolve.h"
+#include "StreamDemux.h"
+#include "ShmPublish.h"
+#include "EpochNotify.h"
+#include "TimeService.h"
+#include "GnssTime.h"
+#ifndef RING_SIZE
+#define RING_SIZE 4096 //读取端与解析端之间的环形缓冲区大小，必须是2的幂
+#endif
 void add_sentence(char *sentence);
+uint32_t add_bytes(const char *data, uint32_t len);
+//直接写输入环形缓冲区（reserve/put/commit或free_spans/commit）的生产者，每次commit后调用mark_input_arrival()
+gps_ring_t *get_input_ring();
+void mark_input_arrival();
+void set_overflow_policy(int policy);
+//UBX、RTCM3帧的回调，在solve_once所在线程调用，frame->data只在回调期间有效（指向解析缓冲区，没有复制）
+typedef void (*gps_frame_handler_t)(const gps_frame_t *frame,void *user);
+void set_frame_handler(gps_frame_handler_t handler,void *user);
+//校验和正确的NMEA语句的回调，在解析之前调用，sentence以'\0'结尾、不含行尾，只在回调期间有效
+typedef void (*gps_sentence_handler_t)(const char *sentence,uint32_t len,void *user);
+void set_sentence_handler(gps_sentence_handler_t handler,void *user);
+#if GPS_ENABLE_SHM
+//每个历元结束时把gps_data发布到共享内存，传NULL停止发布；shm由调用方用gps_shm_publisher_open打开
+void set_shm_publisher(gps_shm_t *shm);
+#endif
+#if GPS_ENABLE_TIME_SERVICE
+//每条RMC/ZDA按到达时刻给NTP SHM写时间样本，传NULL停止；service由调用方用gps_time_service_open打开
+void set_time_service(gps_time_service_t *service);
+#endif
+void get_ring_stats(gps_ring_stats_t *stats);
+void get_metrics_snapshot(gps_metrics_snapshot_t *snapshot);
 void solve_once();
+#if GPS_ENABLE_UBX
+int solve_ubx_frame(const uint8_t *frame, uint32_t len);
+#endif
 gps_data_t* get_gps_data();
 #endif // NMEA0183_GPSSOLVE_H
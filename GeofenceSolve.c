@@ -0,0 +1,346 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "GeofenceSolve.h"
+
+#define GEOFENCE_CELLS_PER_FENCE 4      // 网格数约为围栏数的4倍
+#define GEOFENCE_MAX_CELLS (1u << 20)   // 网格数上限
+#define GEOFENCE_MIN_CELL_SIZE 1e-6     // 最小网格边长（度），防止退化
+
+typedef struct {
+    uint32_t id;
+    double dwell_time;
+    double min_lat, max_lat;
+    double min_lon, max_lon;
+    uint32_t first_vertex;
+    uint32_t vertex_count;
+} geofence_poly_t;
+
+struct gps_geofence_set {
+    int count;
+    geofence_poly_t* polys;
+    gps_geo_point_t* vertices;
+
+    // 均匀网格，cell_items[cell_start[i]..cell_start[i+1]) 为与第i个网格相交的多边形
+    double min_lat, min_lon;
+    double inv_cell_lat, inv_cell_lon;
+    int rows, cols;
+    uint32_t* cell_start;
+    uint32_t* cell_items;
+};
+
+// 把经纬度范围换算为网格行列范围，返回0表示与网格不相交
+static int geofence_cell_range(const gps_geofence_set_t* set, const geofence_poly_t* p,
+                               int* r0, int* r1, int* c0, int* c1) {
+    double fr0 = (p->min_lat - set->min_lat) * set->inv_cell_lat;
+    double fr1 = (p->max_lat - set->min_lat) * set->inv_cell_lat;
+    double fc0 = (p->min_lon - set->min_lon) * set->inv_cell_lon;
+    double fc1 = (p->max_lon - set->min_lon) * set->inv_cell_lon;
+    *r0 = fr0 < 0 ? 0 : (int) fr0;
+    *r1 = fr1 >= set->rows ? set->rows - 1 : (int) fr1;
+    *c0 = fc0 < 0 ? 0 : (int) fc0;
+    *c1 = fc1 >= set->cols ? set->cols - 1 : (int) fc1;
+    return *r0 <= *r1 && *c0 <= *c1;
+}
+
+gps_geofence_set_t* gps_geofence_set_build(const gps_geofence_t* fences, int count) {
+    if (count < 0 || (count > 0 && fences == NULL)) {
+        return NULL;
+    }
+
+    uint32_t total_vertices = 0;
+    for (int i = 0; i < count; i++) {
+        if (fences[i].vertices == NULL || fences[i].vertex_count < 3) {
+            return NULL;
+        }
+        total_vertices += (uint32_t) fences[i].vertex_count;
+    }
+
+    gps_geofence_set_t* set = calloc(1, sizeof(gps_geofence_set_t));
+    if (set == NULL) {
+        return NULL;
+    }
+    set->count = count;
+    set->polys = calloc(count > 0 ? count : 1, sizeof(geofence_poly_t));
+    set->vertices = calloc(total_vertices > 0 ? total_vertices : 1, sizeof(gps_geo_point_t));
+    if (set->polys == NULL || set->vertices == NULL) {
+        gps_geofence_set_free(set);
+        return NULL;
+    }
+
+    // 复制顶点并计算每个多边形及整体的外包矩形
+    double min_lat = 90.0, max_lat = -90.0, min_lon = 180.0, max_lon = -180.0;
+    uint32_t v = 0;
+    for (int i = 0; i < count; i++) {
+        geofence_poly_t* p = &set->polys[i];
+        p->id = fences[i].id;
+        p->dwell_time = fences[i].dwell_time;
+        p->first_vertex = v;
+        p->vertex_count = (uint32_t) fences[i].vertex_count;
+        p->min_lat = 90.0;
+        p->max_lat = -90.0;
+        p->min_lon = 180.0;
+        p->max_lon = -180.0;
+        for (int k = 0; k < fences[i].vertex_count; k++) {
+            gps_geo_point_t pt = fences[i].vertices[k];
+            set->vertices[v++] = pt;
+            if (pt.latitude < p->min_lat) p->min_lat = pt.latitude;
+            if (pt.latitude > p->max_lat) p->max_lat = pt.latitude;
+            if (pt.longitude < p->min_lon) p->min_lon = pt.longitude;
+            if (pt.longitude > p->max_lon) p->max_lon = pt.longitude;
+        }
+        if (p->min_lat < min_lat) min_lat = p->min_lat;
+        if (p->max_lat > max_lat) max_lat = p->max_lat;
+        if (p->min_lon < min_lon) min_lon = p->min_lon;
+        if (p->max_lon > max_lon) max_lon = p->max_lon;
+    }
+    if (count == 0) {
+        min_lat = max_lat = min_lon = max_lon = 0.0;
+    }
+
+    // 按外包矩形长宽比划分网格
+    double height = max_lat - min_lat, width = max_lon - min_lon;
+    if (height < GEOFENCE_MIN_CELL_SIZE) height = GEOFENCE_MIN_CELL_SIZE;
+    if (width < GEOFENCE_MIN_CELL_SIZE) width = GEOFENCE_MIN_CELL_SIZE;
+    double target = (double) count * GEOFENCE_CELLS_PER_FENCE;
+    if (target < 1.0) target = 1.0;
+    if (target > GEOFENCE_MAX_CELLS) target = GEOFENCE_MAX_CELLS;
+    int cols = (int) ceil(sqrt(target * width / height));
+    if (cols < 1) cols = 1;
+    if (cols > (int) GEOFENCE_MAX_CELLS) cols = (int) GEOFENCE_MAX_CELLS;
+    int rows = (int) ceil(target / cols);
+    if (rows < 1) rows = 1;
+    set->rows = rows;
+    set->cols = cols;
+    set->min_lat = min_lat;
+    set->min_lon = min_lon;
+    set->inv_cell_lat = rows / height;
+    set->inv_cell_lon = cols / width;
+
+    // 两遍扫描建立CSR格式的网格索引：先计数，再填充
+    size_t cells = (size_t) rows * cols;
+    set->cell_start = calloc(cells + 1, sizeof(uint32_t));
+    if (set->cell_start == NULL) {
+        gps_geofence_set_free(set);
+        return NULL;
+    }
+    for (int i = 0; i < count; i++) {
+        int r0, r1, c0, c1;
+        if (!geofence_cell_range(set, &set->polys[i], &r0, &r1, &c0, &c1)) {
+            continue;
+        }
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                set->cell_start[(size_t) r * cols + c + 1]++;
+            }
+        }
+    }
+    for (size_t i = 0; i < cells; i++) {
+        set->cell_start[i + 1] += set->cell_start[i];
+    }
+
+    uint32_t total_items = set->cell_start[cells];
+    set->cell_items = calloc(total_items > 0 ? total_items : 1, sizeof(uint32_t));
+    uint32_t* fill = calloc(cells, sizeof(uint32_t));
+    if (set->cell_items == NULL || fill == NULL) {
+        free(fill);
+        gps_geofence_set_free(set);
+        return NULL;
+    }
+    for (int i = 0; i < count; i++) {
+        int r0, r1, c0, c1;
+        if (!geofence_cell_range(set, &set->polys[i], &r0, &r1, &c0, &c1)) {
+            continue;
+        }
+        for (int r = r0; r <= r1; r++) {
+            for (int c = c0; c <= c1; c++) {
+                size_t cell = (size_t) r * cols + c;
+                set->cell_items[set->cell_start[cell] + fill[cell]++] = (uint32_t) i;
+            }
+        }
+    }
+    free(fill);
+    return set;
+}
+
+void gps_geofence_set_free(gps_geofence_set_t* set) {
+    if (set == NULL) {
+        return;
+    }
+    free(set->polys);
+    free(set->vertices);
+    free(set->cell_start);
+    free(set->cell_items);
+    free(set);
+}
+
+int gps_geofence_set_count(const gps_geofence_set_t* set) {
+    return set != NULL ? set->count : 0;
+}
+
+// 射线法判断点是否在多边形内
+static int geofence_contains(const gps_geofence_set_t* set, const geofence_poly_t* p, double lat, double lon) {
+    if (lat < p->min_lat || lat > p->max_lat || lon < p->min_lon || lon > p->max_lon) {
+        return 0;
+    }
+    const gps_geo_point_t* vs = set->vertices + p->first_vertex;
+    int inside = 0;
+    for (uint32_t i = 0, j = p->vertex_count - 1; i < p->vertex_count; j = i++) {
+        if ((vs[i].latitude > lat) != (vs[j].latitude > lat)) {
+            double cross = vs[j].longitude + (lat - vs[j].latitude) * (vs[i].longitude - vs[j].longitude) /
+                                             (vs[i].latitude - vs[j].latitude);
+            if (lon < cross) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+void gps_geofence_engine_init(gps_geofence_engine_t* engine, gps_geofence_callback_t callback, void* user) {
+    memset(engine, 0, sizeof(gps_geofence_engine_t));
+    atomic_init(&engine->current, NULL);
+    atomic_init(&engine->hazard, NULL);
+    engine->callback = callback;
+    engine->user = user;
+}
+
+// 替换围栏集合，返回旧集合；返回时评估线程已不再使用旧集合，可以直接释放
+gps_geofence_set_t* gps_geofence_engine_swap(gps_geofence_engine_t* engine, gps_geofence_set_t* set) {
+    gps_geofence_set_t* old = atomic_exchange(&engine->current, set);
+    while (old != NULL && atomic_load(&engine->hazard) == old) {
+        // 评估一次不到1微秒，直接自旋等待
+    }
+    return old;
+}
+
+static void geofence_emit(gps_geofence_engine_t* engine, int type, const gps_geofence_inside_t* fence,
+                          double lat, double lon, double timestamp) {
+    if (engine->callback == NULL) {
+        return;
+    }
+    gps_geofence_event_t event;
+    event.type = type;
+    event.fence_id = fence->fence_id;
+    event.timestamp = timestamp;
+    event.duration = type == GPS_GEOFENCE_ENTER ? 0.0 : timestamp - fence->enter_time;
+    event.latitude = lat;
+    event.longitude = lon;
+    engine->callback(&event, engine->user);
+}
+
+// 用一次定位更新围栏状态，返回产生的事件数
+int gps_geofence_evaluate(gps_geofence_engine_t* engine, double latitude, double longitude, double timestamp) {
+    if (engine == NULL) {
+        return -1;
+    }
+
+    // 发布危险指针后再确认一次，保证替换方能看到我们正在使用的集合
+    gps_geofence_set_t* set;
+    do {
+        set = atomic_load(&engine->current);
+        atomic_store(&engine->hazard, set);
+    } while (set != atomic_load(&engine->current));
+
+    gps_geofence_inside_t hits[GPS_GEOFENCE_MAX_INSIDE];
+    int hit_count = 0;
+    if (set != NULL) {
+        int row = (int) floor((latitude - set->min_lat) * set->inv_cell_lat);
+        int col = (int) floor((longitude - set->min_lon) * set->inv_cell_lon);
+        // 恰好落在网格上边界或右边界的点归入最后一行/列
+        if (row == set->rows) row--;
+        if (col == set->cols) col--;
+        if (row >= 0 && row < set->rows && col >= 0 && col < set->cols) {
+            size_t cell = (size_t) row * set->cols + col;
+            for (uint32_t k = set->cell_start[cell]; k < set->cell_start[cell + 1]; k++) {
+                const geofence_poly_t* p = &set->polys[set->cell_items[k]];
+                if (hit_count < GPS_GEOFENCE_MAX_INSIDE && geofence_contains(set, p, latitude, longitude)) {
+                    hits[hit_count].fence_id = p->id;
+                    hits[hit_count].dwell_time = p->dwell_time;
+                    hit_count++;
+                }
+            }
+        }
+    }
+    atomic_store_explicit(&engine->hazard, NULL, memory_order_release);
+
+    int events = 0;
+
+    // 离开：之前在内，这次不在
+    for (int i = 0; i < engine->inside_count;) {
+        int found = 0;
+        for (int k = 0; k < hit_count; k++) {
+            if (hits[k].fence_id == engine->inside[i].fence_id) {
+                found = 1;
+                break;
+            }
+        }
+        if (found) {
+            i++;
+            continue;
+        }
+        geofence_emit(engine, GPS_GEOFENCE_EXIT, &engine->inside[i], latitude, longitude, timestamp);
+        events++;
+        engine->inside[i] = engine->inside[--engine->inside_count];
+    }
+
+    // 进入：这次在内，之前不在
+    for (int k = 0; k < hit_count; k++) {
+        int found = 0;
+        for (int i = 0; i < engine->inside_count; i++) {
+            if (engine->inside[i].fence_id == hits[k].fence_id) {
+                found = 1;
+                break;
+            }
+        }
+        if (found) {
+            continue;
+        }
+        gps_geofence_inside_t* entry = &engine->inside[engine->inside_count++];
+        entry->fence_id = hits[k].fence_id;
+        entry->dwell_time = hits[k].dwell_time;
+        entry->enter_time = timestamp;
+        entry->dwell_reported = 0;
+        geofence_emit(engine, GPS_GEOFENCE_ENTER, entry, latitude, longitude, timestamp);
+        events++;
+    }
+
+    // 停留：每次进入只报告一次
+    for (int i = 0; i < engine->inside_count; i++) {
+        gps_geofence_inside_t* entry = &engine->inside[i];
+        if (entry->dwell_time > 0.0 && !entry->dwell_reported && timestamp - entry->enter_time >= entry->dwell_time) {
+            entry->dwell_reported = 1;
+            geofence_emit(engine, GPS_GEOFENCE_DWELL, entry, latitude, longitude, timestamp);
+            events++;
+        }
+    }
+
+    return events;
+}
+
+// 用一个历元的位置评估，优先GGA，其次RMC
+// 返回事件数；-2=没有有效定位，-4=定位语句的时刻没有前进：上一个历元留下的旧位置不再评估，
+// 否则会拿旧位置配上新的timestamp，把停留时长算长、误报停留事件
+int gps_geofence_evaluate_epoch(gps_geofence_engine_t* engine, const gps_data_t* data, double timestamp) {
+    if (engine == NULL || data == NULL) {
+        return -1;
+    }
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    if (gga->has_latitude && gga->has_longitude && gga->fix_quality > 0) {
+        if (gga->has_time && !gps_tod_mark_advance(&engine->fix_mark, gga->hour, gga->minute, gga->second)) {
+            return -4;
+        }
+        return gps_geofence_evaluate(engine, GPS_TO_DOUBLE(gga->latitude, DEGREE), GPS_TO_DOUBLE(gga->longitude, DEGREE),
+                                     timestamp);
+    }
+    if (rmc->has_latitude && rmc->has_longitude && rmc->status == 1) {
+        if (rmc->has_time && !gps_tod_mark_advance(&engine->fix_mark, rmc->hour, rmc->minute, rmc->second)) {
+            return -4;
+        }
+        return gps_geofence_evaluate(engine, GPS_TO_DOUBLE(rmc->latitude, DEGREE), GPS_TO_DOUBLE(rmc->longitude, DEGREE),
+                                     timestamp);
+    }
+    return -2;
+}
@@ -0,0 +1,80 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_GEOFENCESOLVE_H
+#define NMEA0183_GEOFENCESOLVE_H
+#include <stdatomic.h>
+#include "NMEA0183Solve.h"
+#include "GnssTime.h"
+
+// 地理围栏
+// 围栏集合构建时建立均匀网格索引，每次定位只检查所在网格内的候选多边形
+// 围栏集合构建后只读，可以在另一个线程中构建好再整体替换，替换时不需要停止解析
+// 评估（gps_geofence_evaluate）只能在一个线程中调用，一般就是解析线程
+// 多边形按经纬度平面处理，不支持跨越180度经线的多边形
+
+#define GPS_GEOFENCE_MAX_INSIDE 64  // 同时所在围栏的最大数量
+
+#define GPS_GEOFENCE_ENTER 0        // 进入
+#define GPS_GEOFENCE_EXIT 1         // 离开
+#define GPS_GEOFENCE_DWELL 2        // 停留超过设定时长
+
+typedef struct {
+    double latitude;           // 纬度（度）
+    double longitude;          // 经度（度）
+} gps_geo_point_t;
+
+// 围栏描述（构建时使用，构建后顶点会被复制）
+typedef struct {
+    uint32_t id;               // 围栏编号，集合内唯一
+    double dwell_time;         // 停留事件触发时长（秒），0表示不产生停留事件
+    const gps_geo_point_t* vertices;
+    int vertex_count;          // 顶点数，至少3个，首尾不需要重复
+} gps_geofence_t;
+
+typedef struct {
+    int type;                  // 事件类型：GPS_GEOFENCE_ENTER/EXIT/DWELL
+    uint32_t fence_id;         // 围栏编号
+    double timestamp;          // 触发事件的定位时刻（秒）
+    double duration;           // 已在围栏内的时长（秒），进入事件为0
+    double latitude;           // 触发事件的定位纬度
+    double longitude;          // 触发事件的定位经度
+} gps_geofence_event_t;
+
+typedef void (*gps_geofence_callback_t)(const gps_geofence_event_t* event, void* user);
+
+// 构建好的围栏集合（只读），内部结构不对外公开
+typedef struct gps_geofence_set gps_geofence_set_t;
+
+// 当前所在的围栏
+typedef struct {
+    uint32_t fence_id;
+    double enter_time;
+    double dwell_time;
+    int dwell_reported;
+} gps_geofence_inside_t;
+
+typedef struct {
+    _Atomic(gps_geofence_set_t*) current;  // 当前生效的围栏集合
+    _Atomic(gps_geofence_set_t*) hazard;   // 评估线程正在使用的集合，替换方据此判断旧集合何时可以释放
+
+    gps_geofence_callback_t callback;
+    void* user;
+
+    // 以下只由评估线程访问
+    gps_geofence_inside_t inside[GPS_GEOFENCE_MAX_INSIDE];
+    int inside_count;
+    gps_tod_mark_t fix_mark;   // gps_geofence_evaluate_epoch上次用的定位语句时刻
+} gps_geofence_engine_t;
+
+gps_geofence_set_t* gps_geofence_set_build(const gps_geofence_t* fences, int count);
+void gps_geofence_set_free(gps_geofence_set_t* set);
+int gps_geofence_set_count(const gps_geofence_set_t* set);
+
+void gps_geofence_engine_init(gps_geofence_engine_t* engine, gps_geofence_callback_t callback, void* user);
+gps_geofence_set_t* gps_geofence_engine_swap(gps_geofence_engine_t* engine, gps_geofence_set_t* set);
+int gps_geofence_evaluate(gps_geofence_engine_t* engine, double latitude, double longitude, double timestamp);
+int gps_geofence_evaluate_epoch(gps_geofence_engine_t* engine, const gps_data_t* data, double timestamp);
+
+#endif // NMEA0183_GEOFENCESOLVE_H
@@ -0,0 +1,166 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "GnssTime.h"
+
+#define GNSS_GPS_EPOCH_S 315964800LL      // 1980-01-06 00:00:00 UTC
+#define GNSS_BDS_EPOCH_S 1136073600LL     // 2006-01-01 00:00:00 UTC，北斗时和UTC在这一刻对齐
+#define GNSS_BDS_LEAP_AT_EPOCH 14         // 当时的GPS-UTC
+#define GNSS_GST_WEEK_OFFSET 1024         // Galileo周从GPS第1024周（1999-08-22）开始
+#define GNSS_TOD_RESET_NS (60LL * GNSS_NS_PER_SECOND)
+
+// 闰秒表：从这一刻（Unix秒）起GPS-UTC的秒数
+static const struct {
+    int64_t since_s;
+    int gps_minus_utc;
+} leap_table[] = {
+        {362793600LL, 1},  {394329600LL, 2},  {425865600LL, 3},  {489024000LL, 4},
+        {567993600LL, 5},  {631152000LL, 6},  {662688000LL, 7},  {709948800LL, 8},
+        {741484800LL, 9},  {773020800LL, 10}, {820454400LL, 11}, {867715200LL, 12},
+        {915148800LL, 13}, {1136073600LL, 14}, {1230768000LL, 15}, {1341100800LL, 16},
+        {1435708800LL, 17}, {1483228800LL, 18},
+};
+#define LEAP_COUNT (int) (sizeof(leap_table) / sizeof(leap_table[0]))
+
+// 公历日期 -> 距1970-01-01的天数
+int64_t gps_days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yoe = year - era * 400;
+    int64_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// 距1970-01-01的天数 -> 公历日期，gps_days_from_civil的逆运算
+void gps_civil_from_days(int64_t days, int* year, int* month, int* day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    *day = (int) (doy - (153 * mp + 2) / 5 + 1);
+    *month = (int) (mp < 10 ? mp + 3 : mp - 9);
+    *year = (int) (yoe + era * 400 + (*month <= 2));
+}
+
+// 当天0点的Unix纳秒，日期没变时直接返回缓存
+int64_t gps_day_cache_ns(gps_day_cache_t* cache, int year, int month, int day) {
+    if (cache->year != year || cache->month != month || cache->day != day) {
+        cache->year = year;
+        cache->month = month;
+        cache->day = day;
+        cache->day_ns = gps_days_from_civil(year, month, day) * GNSS_NS_PER_DAY;
+    }
+    return cache->day_ns;
+}
+
+// 时:分:秒 -> 当天的纳秒数；整数模式下秒是毫秒，全程整数运算
+// 浮点模式不用llround：加0.5再截断就够了，免得最小配置为这一处把libm拉进来
+int64_t gps_tod_ns(int hour, int minute, gps_second_t second) {
+    int64_t ns = (hour * 3600LL + minute * 60LL) * GNSS_NS_PER_SECOND;
+#if GPS_INTEGER_ONLY
+    return ns + (int64_t) second * (GNSS_NS_PER_SECOND / GPS_SECOND_SCALE);
+#else
+    double second_ns = second * 1e9;
+    return ns + (int64_t) (second_ns >= 0 ? second_ns + 0.5 : second_ns - 0.5);
+#endif
+}
+
+// 时刻比上次记录的新就记下并返回1，没有前进（同一条旧语句）返回0
+// 跨过午夜按第二天算；倒退超过GNSS_TOD_RESET_NS当作接收机时间被重置，重新开始记录
+int gps_tod_mark_advance(gps_tod_mark_t* mark, int hour, int minute, gps_second_t second) {
+    int64_t tod_ns = gps_tod_ns(hour, minute, second);
+    if (mark->valid) {
+        int64_t delta = tod_ns - mark->tod_ns;
+        if (delta < -GNSS_NS_PER_DAY / 2) {
+            delta += GNSS_NS_PER_DAY;
+        } else if (delta > GNSS_NS_PER_DAY / 2) {
+            delta -= GNSS_NS_PER_DAY;
+        }
+        if (delta <= 0 && delta > -GNSS_TOD_RESET_NS) {
+            return 0;
+        }
+    }
+    mark->tod_ns = tod_ns;
+    mark->valid = 1;
+    return 1;
+}
+
+// utc_ns时刻的GPS-UTC（秒），1981年以前是0
+int gps_leap_seconds(int64_t utc_ns) {
+    int64_t seconds = utc_ns / GNSS_NS_PER_SECOND;
+    for (int i = LEAP_COUNT - 1; i >= 0; i--) {
+        if (seconds >= leap_table[i].since_s) {
+            return leap_table[i].gps_minus_utc;
+        }
+    }
+    return 0;
+}
+
+// UTC -> 指定系统的周数和周内纳秒（GNSS_TIME_*）
+// 返回：0=成功，-1=空指针，-2=不认识的系统，-3=早于该系统的起点
+int gps_utc_to_week(int64_t utc_ns, int system, int* week, int64_t* tow_ns) {
+    if (week == NULL || tow_ns == NULL) {
+        return -1;
+    }
+    int leap = gps_leap_seconds(utc_ns);
+    int64_t since_ns;
+    switch (system) {
+        case GNSS_TIME_GPS:
+        case GNSS_TIME_GALILEO: // Galileo系统时和GPS时只差整周
+            since_ns = utc_ns - GNSS_GPS_EPOCH_S * GNSS_NS_PER_SECOND + leap * GNSS_NS_PER_SECOND;
+            break;
+        case GNSS_TIME_BEIDOU:
+            since_ns = utc_ns - GNSS_BDS_EPOCH_S * GNSS_NS_PER_SECOND +
+                       (leap - GNSS_BDS_LEAP_AT_EPOCH) * GNSS_NS_PER_SECOND;
+            break;
+        default:
+            return -2;
+    }
+    if (since_ns < 0) {
+        return -3;
+    }
+    int64_t week_ns = GNSS_SECONDS_PER_WEEK * GNSS_NS_PER_SECOND;
+    *week = (int) (since_ns / week_ns);
+    *tow_ns = since_ns % week_ns;
+    if (system == GNSS_TIME_GALILEO) {
+        if (*week < GNSS_GST_WEEK_OFFSET) {
+            return -3;
+        }
+        *week -= GNSS_GST_WEEK_OFFSET;
+    }
+    return 0;
+}
+
+// 计算历元的utc_ns：RMC、ZDA带日期，GGA只有时刻，用最近一次已知的日期
+// 低频输出的语句会在gps_data_t里留着旧值，所以取几个来源里最新的时间
+// GGA比参考时间（本历元的RMC/ZDA，或上一个历元）倒退大半天说明跨过了UTC午夜，按第二天算
+void gps_epoch_time_update(gps_data_t* data, gps_day_cache_t* cache) {
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    const gps_zda_t* zda = gps_data_zda(data);
+    const gps_gga_t* gga = gps_data_gga(data);
+    int64_t best = INT64_MIN;
+    if (rmc->has_time && rmc->has_date) {
+        best = gps_day_cache_ns(cache, rmc->year, rmc->month, rmc->day) + gps_tod_ns(rmc->hour, rmc->minute, rmc->second);
+    }
+    if (zda->has_time && zda->has_date) {
+        int64_t utc_ns = gps_day_cache_ns(cache, zda->year, zda->month, zda->day) +
+                         gps_tod_ns(zda->hour, zda->minute, zda->second);
+        best = utc_ns > best ? utc_ns : best;
+    }
+    if (gga->has_time && cache->year != 0) {
+        int64_t utc_ns = cache->day_ns + gps_tod_ns(gga->hour, gga->minute, gga->second);
+        int64_t reference = best != INT64_MIN ? best : data->has_utc_ns ? data->utc_ns : INT64_MIN;
+        if (reference != INT64_MIN && utc_ns < reference - GNSS_NS_PER_DAY / 2) {
+            utc_ns += GNSS_NS_PER_DAY;
+        }
+        best = utc_ns > best ? utc_ns : best;
+    }
+    data->has_utc_ns = best != INT64_MIN;
+    if (data->has_utc_ns) {
+        data->utc_ns = best;
+    }
+}
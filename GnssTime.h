@@ -0,0 +1,46 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_GNSSTIME_H
+#define NMEA0183_GNSSTIME_H
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+
+// UTC时间戳（Unix纪元纳秒，整数）和GNSS时间系统换算
+// 日期部分用Howard Hinnant的days_from_civil纯整数计算，不调用mktime/timegm，不碰时区；
+// gps_day_cache_t记住上一次的日期，只有跨天时才重新计算
+// GPS/北斗/Galileo的周+周内秒由内置闰秒表换算，表里最后一次闰秒是2017-01-01（GPS-UTC=18秒）
+
+#define GNSS_TIME_GPS 0
+#define GNSS_TIME_GALILEO 1
+#define GNSS_TIME_BEIDOU 2
+
+#define GNSS_NS_PER_SECOND 1000000000LL
+#define GNSS_NS_PER_DAY (86400LL * GNSS_NS_PER_SECOND)
+#define GNSS_SECONDS_PER_WEEK 604800LL
+
+typedef struct {
+    int year;                  // 0表示还没有缓存
+    int month;
+    int day;
+    int64_t day_ns;            // 当天0点的Unix纳秒
+} gps_day_cache_t;
+
+// 某种语句上一次被使用时的UTC当天时刻
+// gps_data_t在历元之间不清空，低频语句会一直留着旧值；滤波、推算等下游模块用它跳过时间没有前进的旧数据
+typedef struct {
+    int64_t tod_ns;
+    int valid;                 // 0表示还没有记录
+} gps_tod_mark_t;
+
+int64_t gps_days_from_civil(int year, int month, int day);
+void gps_civil_from_days(int64_t days, int* year, int* month, int* day);
+int64_t gps_day_cache_ns(gps_day_cache_t* cache, int year, int month, int day);
+int64_t gps_tod_ns(int hour, int minute, gps_second_t second);
+int gps_tod_mark_advance(gps_tod_mark_t* mark, int hour, int minute, gps_second_t second);
+int gps_leap_seconds(int64_t utc_ns);
+int gps_utc_to_week(int64_t utc_ns, int system, int* week, int64_t* tow_ns);
+void gps_epoch_time_update(gps_data_t* data, gps_day_cache_t* cache);
+
+#endif // NMEA0183_GNSSTIME_H
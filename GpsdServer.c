@@ -0,0 +1,588 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "GpsdServer.h"
+#include <stdarg.h>
+#include "GnssTime.h"
+
+#define GPSD_KNOTS_TO_MPS 0.514444444
+
+// 追加格式化文本，放不下时返回-2（out里的内容作废）
+static int json_append(char* out, size_t size, size_t* len, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(out + *len, size - *len, format, args);
+    va_end(args);
+    if (n < 0 || (size_t) n >= size - *len) {
+        return -2;
+    }
+    *len += (size_t) n;
+    return 0;
+}
+
+#define JSON_APPEND(...)                                   \
+    do {                                                   \
+        if (json_append(out, size, &len, __VA_ARGS__) != 0) { \
+            return -2;                                     \
+        }                                                  \
+    } while (0)
+
+// 历元的UTC时间，用solve_once算好的utc_ns（RMC/ZDA/GGA里最新的那个，GGA借用最近的日期）
+static int json_time(const gps_data_t* data, char* out, size_t size) {
+    if (!data->has_utc_ns || data->utc_ns < 0) {
+        return 0;
+    }
+    int64_t days = data->utc_ns / GNSS_NS_PER_DAY;
+    int64_t ms = data->utc_ns % GNSS_NS_PER_DAY / 1000000LL;
+    int year, month, day;
+    gps_civil_from_days(days, &year, &month, &day);
+    int n = snprintf(out, size, "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", year, month, day, (int) (ms / 3600000),
+                     (int) (ms / 60000 % 60), (int) (ms / 1000 % 60), (int) (ms % 1000));
+    return n > 0 && (size_t) n < size;
+}
+
+// 语句是不是本历元更新的：低频语句在gps_data_t里留着旧值，它的时刻会落后于utc_ns
+// 没有时刻的语句（或者历元没有utc_ns）分不出新旧，当作新的
+static int json_fresh(const gps_data_t* data, int has_time, int hour, int minute, gps_second_t second) {
+    if (!has_time || !data->has_utc_ns || data->utc_ns < 0) {
+        return 1;
+    }
+    return gps_tod_ns(hour, minute, second) == data->utc_ns % GNSS_NS_PER_DAY;
+}
+
+// gpsd的mode：0=未知，1=无定位，2=2D，3=3D
+static int json_mode(const gps_data_t* data) {
+    int mode = 0;
+#if GPS_ENABLE_SATELLITES
+    for (int i = 0; i < MAX_KIND_OF_SATELLITE; i++) {
+        const gps_gsa_t* gsa = &data->satellites.gsa[i];
+        if (gsa->has_mode2 && gsa->mode2 > mode) {
+            mode = gsa->mode2;
+        }
+    }
+    if (mode > 0) {
+        return mode;
+    }
+#endif
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    if (gga->has_fix_quality) {
+        return gga->fix_quality == 0 ? 1 : (gga->has_altitude ? 3 : 2);
+    }
+    if (rmc->has_status) {
+        return rmc->status == 1 ? 2 : 1;
+    }
+    return mode;
+}
+
+// GGA定位质量换成gpsd的status：1=普通，2=DGPS，3=RTK固定，4=RTK浮点，5=航位推算，7=手动，8=模拟
+static int json_status(int fix_quality) {
+    static const int map[9] = {0, 1, 2, 1, 3, 4, 5, 7, 8};
+    return fix_quality >= 0 && fix_quality <= 8 ? map[fix_quality] : 0;
+}
+
+int gps_json_tpv(const gps_data_t* data, const char* device, char* out, size_t size) {
+    if (data == NULL || out == NULL) {
+        return -1;
+    }
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    const gps_vtg_t* vtg = gps_data_vtg(data);
+    int gga_fresh = json_fresh(data, gga->has_time, gga->hour, gga->minute, gga->second);
+    int rmc_fresh = json_fresh(data, rmc->has_time, rmc->hour, rmc->minute, rmc->second);
+    size_t len = 0;
+    char time[32];
+
+    JSON_APPEND("{\"class\":\"TPV\",\"device\":\"%s\",\"mode\":%d", device != NULL ? device : "", json_mode(data));
+    if (gga->has_fix_quality && json_status(gga->fix_quality) > 1) {
+        JSON_APPEND(",\"status\":%d", json_status(gga->fix_quality));
+    }
+    if (json_time(data, time, sizeof(time))) {
+        JSON_APPEND(",\"time\":\"%s\"", time);
+    }
+    // 位置取本历元更新过的GGA，其次更新过的RMC；都不是新的就不报，免得旧位置配上新时间
+    if (gga_fresh && gga->has_latitude && gga->has_longitude) {
+        JSON_APPEND(",\"lat\":%.9f,\"lon\":%.9f", GPS_TO_DOUBLE(gga->latitude, DEGREE),
+                    GPS_TO_DOUBLE(gga->longitude, DEGREE));
+    } else if (rmc_fresh && rmc->has_latitude && rmc->has_longitude) {
+        JSON_APPEND(",\"lat\":%.9f,\"lon\":%.9f", GPS_TO_DOUBLE(rmc->latitude, DEGREE),
+                    GPS_TO_DOUBLE(rmc->longitude, DEGREE));
+    }
+    if (gga_fresh && gga->has_altitude) {
+        double msl = GPS_TO_DOUBLE(gga->altitude, METER);
+        JSON_APPEND(",\"altMSL\":%.3f", msl);
+        if (gga->has_geoid_height) {
+            double geoid = GPS_TO_DOUBLE(gga->geoid_height, METER);
+            JSON_APPEND(",\"altHAE\":%.3f,\"alt\":%.3f,\"geoidSep\":%.3f", msl + geoid, msl, geoid);
+        }
+    }
+    // 速度航向取本历元更新过的RMC，其次VTG（VTG没有时刻，分不出新旧）
+    if (rmc_fresh && rmc->has_speed) {
+        JSON_APPEND(",\"speed\":%.3f", GPS_TO_DOUBLE(rmc->speed_over_ground, SPEED) * GPSD_KNOTS_TO_MPS);
+    } else if (vtg->has_speed_knots) {
+        JSON_APPEND(",\"speed\":%.3f", GPS_TO_DOUBLE(vtg->speed_knots, SPEED) * GPSD_KNOTS_TO_MPS);
+    }
+    if (rmc_fresh && rmc->has_course) {
+        JSON_APPEND(",\"track\":%.4f", GPS_TO_DOUBLE(rmc->course_over_ground, ANGLE));
+    } else if (vtg->has_true_course) {
+        JSON_APPEND(",\"track\":%.4f", GPS_TO_DOUBLE(vtg->course_true, ANGLE));
+    }
+    if (vtg->has_magnetic_course) {
+        JSON_APPEND(",\"magtrack\":%.4f", GPS_TO_DOUBLE(vtg->course_magnetic, ANGLE));
+    }
+    if (rmc_fresh && rmc->has_magnetic_variation) {
+        double variation = GPS_TO_DOUBLE(rmc->magnetic_variation, ANGLE);
+        JSON_APPEND(",\"magvar\":%.1f", rmc->is_magnetic_east == 0 ? -variation : variation);
+    }
+    if (gga_fresh && gga->has_diff_age) {
+        JSON_APPEND(",\"dgpsAge\":%.1f", GPS_TO_DOUBLE(gga->diff_age, SECOND));
+    }
+    if (gga_fresh && gga->has_diff_station) {
+        JSON_APPEND(",\"dgpsSta\":%d", gga->diff_station_id);
+    }
+    JSON_APPEND("}\r\n");
+    return (int) len;
+}
+
+#if GPS_ENABLE_SATELLITES
+// talker（或GSA的系统ID）换成gpsd的gnssid（和UBX一致）：0=GPS，2=Galileo，3=BeiDou，5=QZSS，6=GLONASS
+// 'N'（GN语句没有系统ID字段）分不出系统，返回-1
+static int json_gnssid(char system_id) {
+    switch (system_id) {
+        case 'L': return 6;
+        case 'A': return 2;
+        case 'B':
+        case 'D': return 3;
+        case 'Q': return 5;
+        case 'N': return -1;
+        default: return 0;
+    }
+}
+
+// 卫星是否在同一系统的GSA里；不同系统的PRN会重号（GPS 04和北斗04），只按PRN比会算错
+// 分不出系统的GSA只能按PRN比
+static int json_used(const gps_data_t* data, int gnssid, int prn) {
+    for (int i = 0; i < MAX_KIND_OF_SATELLITE; i++) {
+        const gps_gsa_t* gsa = &data->satellites.gsa[i];
+        int system = gsa->has_system_id ? json_gnssid(gsa->system_id) : -1;
+        if (system >= 0 && gnssid >= 0 && system != gnssid) {
+            continue;
+        }
+        for (int k = 0; k < gsa->satellite_count && k < 12; k++) {
+            if (gsa->satellites[k] == prn) {
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int gps_json_sky(const gps_data_t* data, const char* device, char* out, size_t size) {
+    if (data == NULL || out == NULL) {
+        return -1;
+    }
+    size_t len = 0;
+    char time[32];
+    JSON_APPEND("{\"class\":\"SKY\",\"device\":\"%s\"", device != NULL ? device : "");
+    if (json_time(data, time, sizeof(time))) {
+        JSON_APPEND(",\"time\":\"%s\"", time);
+    }
+    // DOP取第一条带这个值的GSA（各系统的GSA给的是同一个组合解）
+    const char* names[3] = {"pdop", "hdop", "vdop"};
+    for (int d = 0; d < 3; d++) {
+        for (int i = 0; i < MAX_KIND_OF_SATELLITE; i++) {
+            const gps_gsa_t* gsa = &data->satellites.gsa[i];
+            int has = d == 0 ? gsa->has_pdop : d == 1 ? gsa->has_hdop : gsa->has_vdop;
+            if (has) {
+                gps_dop_t dop = d == 0 ? gsa->pdop : d == 1 ? gsa->hdop : gsa->vdop;
+                JSON_APPEND(",\"%s\":%.2f", names[d], GPS_TO_DOUBLE(dop, DOP));
+                break;
+            }
+        }
+    }
+
+    int seen = 0;
+    int used = 0;
+    JSON_APPEND(",\"satellites\":[");
+    for (int i = 0; i < MAX_KIND_OF_SATELLITE; i++) {
+        for (int j = 0; j < EACH_KIND_OF_SATELLITE; j++) {
+            const gps_gsv_t* gsv = &data->satellites.gsv[i][j];
+            for (int k = 0; k < gsv->satellite_count && k < 4; k++) {
+                const satellite_info_t* sat = &gsv->satellites[k];
+                if (!sat->is_valid || sat->prn <= 0) {
+                    continue;
+                }
+                int system = gsv->has_system_id ? json_gnssid(gsv->system_id) : -1;
+                int is_used = json_used(data, system, sat->prn);
+                // GP语句里的193~202是QZSS
+                int gnssid = system == 0 && sat->prn >= 193 && sat->prn <= 202 ? 5 : system < 0 ? 0 : system;
+                JSON_APPEND("%s{\"PRN\":%d,\"gnssid\":%d", seen ? "," : "", sat->prn, gnssid);
+                if (sat->elevation >= 0 && sat->azimuth >= 0) {
+                    JSON_APPEND(",\"el\":%d,\"az\":%d", sat->elevation, sat->azimuth);
+                }
+                if (sat->snr >= 0) {
+                    JSON_APPEND(",\"ss\":%d", sat->snr);
+                }
+                JSON_APPEND(",\"used\":%s}", is_used ? "true" : "false");
+                seen++;
+                used += is_used;
+            }
+        }
+    }
+    JSON_APPEND("],\"nSat\":%d,\"uSat\":%d}\r\n", seen, used);
+    return (int) len;
+}
+#endif
+
+#if GPS_ENABLE_GPSD
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+_Static_assert((GPSD_BACKLOG & (GPSD_BACKLOG - 1)) == 0, "GPSD_BACKLOG must be a power of two");
+
+#define GPSD_TAG_LISTEN GPSD_MAX_CLIENTS
+#define GPSD_MASK (GPSD_BACKLOG - 1)
+
+static int gpsd_watch(gpsd_server_t* server, int fd, uint32_t events, uint32_t tag, int op) {
+    struct epoll_event event = {.events = events, .data.u32 = tag};
+    return epoll_ctl(server->epoll_fd, op, fd, &event);
+}
+
+// 监听gpsd端口，bind_address为NULL时只监听本机，device是TPV/SKY里报告的设备名
+// 返回：0=成功，-1=空指针，-2=epoll创建失败，-3=端口打开失败
+int gpsd_server_open(gpsd_server_t* server, const char* bind_address, uint16_t port, const char* device) {
+    if (server == NULL) {
+        return -1;
+    }
+    server->head = 0;
+    server->epochs = 0;
+    server->dropped = 0;
+    server->listen_fd = -1;
+    strncpy(server->device, device != NULL ? device : "nmea0183", sizeof(server->device) - 1);
+    server->device[sizeof(server->device) - 1] = '\0';
+    for (int i = 0; i < GPSD_MAX_CLIENTS; i++) {
+        server->clients[i].fd = -1;
+    }
+    server->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (server->epoll_fd < 0) {
+        return -2;
+    }
+
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons(port != 0 ? port : GPSD_DEFAULT_PORT)};
+    int fd = -1;
+    int one = 1;
+    if (inet_pton(AF_INET, bind_address != NULL ? bind_address : "127.0.0.1", &addr.sin_addr) != 1 ||
+        (fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)) < 0 ||
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0 ||
+        bind(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(fd, 16) != 0 ||
+        gpsd_watch(server, fd, EPOLLIN, GPSD_TAG_LISTEN, EPOLL_CTL_ADD) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        gpsd_server_close(server);
+        return -3;
+    }
+    server->listen_fd = fd;
+    return 0;
+}
+
+static void gpsd_drop(gpsd_server_t* server, int index) {
+    gpsd_client_t* client = &server->clients[index];
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    client->fd = -1;
+}
+
+// 发送待发数据：应答只在积压数据发完（行边界）时开始，开始后先发完；之后再发积压缓冲区
+static void gpsd_flush(gpsd_server_t* server, int index) {
+    gpsd_client_t* client = &server->clients[index];
+    for (;;) {
+        struct iovec iov[2];
+        struct msghdr msg = {.msg_iov = iov, .msg_iovlen = 1};
+        int replying = client->reply_sent < client->reply_len && (client->reply_sent > 0 || client->cursor == server->head);
+        if (replying) {
+            iov[0].iov_base = client->reply + client->reply_sent;
+            iov[0].iov_len = client->reply_len - client->reply_sent;
+        } else if (client->cursor != server->head) {
+            size_t start = (size_t) (client->cursor & GPSD_MASK);
+            size_t pending = (size_t) (server->head - client->cursor);
+            size_t first = GPSD_BACKLOG - start < pending ? GPSD_BACKLOG - start : pending;
+            iov[0].iov_base = server->backlog + start;
+            iov[0].iov_len = first;
+            iov[1].iov_base = server->backlog;
+            iov[1].iov_len = pending - first;
+            msg.msg_iovlen = iov[1].iov_len > 0 ? 2 : 1;
+        } else {
+            break;
+        }
+        ssize_t n = sendmsg(client->fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            gpsd_drop(server, index);
+            return;
+        }
+        if (replying) {
+            client->reply_sent += (uint32_t) n;
+            if (client->reply_sent == client->reply_len) {
+                client->reply_sent = 0;
+                client->reply_len = 0;
+            }
+        } else {
+            client->cursor += (uint64_t) n;
+        }
+    }
+    int want_write = client->reply_len > 0 || client->cursor != server->head;
+    if (want_write != client->want_write) {
+        gpsd_watch(server, client->fd, want_write ? EPOLLIN | EPOLLOUT : EPOLLIN, (uint32_t) index, EPOLL_CTL_MOD);
+        client->want_write = want_write;
+    }
+}
+
+// 追加应答，放不下说明客户端一直不收，断开
+static int gpsd_reply(gpsd_server_t* server, int index, const char* format, ...) {
+    gpsd_client_t* client = &server->clients[index];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(client->reply + client->reply_len, GPSD_REPLY_SIZE - client->reply_len, format, args);
+    va_end(args);
+    if (n < 0 || (uint32_t) n >= GPSD_REPLY_SIZE - client->reply_len) {
+        gpsd_drop(server, index);
+        server->dropped++;
+        return -2;
+    }
+    client->reply_len += (uint32_t) n;
+    return 0;
+}
+
+static int gpsd_reply_devices(gpsd_server_t* server, int index) {
+    return gpsd_reply(server, index,
+                      "{\"class\":\"DEVICES\",\"devices\":[{\"class\":\"DEVICE\",\"path\":\"%s\",\"driver\":\"NMEA0183\","
+                      "\"flags\":1,\"native\":0}]}\r\n",
+                      server->device);
+}
+
+// ?WATCH={"enable":false}才关闭，没有enable或其它值都是打开
+static int gpsd_watch_enabled(const char* request) {
+    const char* enable = strstr(request, "\"enable\"");
+    if (enable == NULL) {
+        return 1;
+    }
+    enable += 8;
+    enable += strspn(enable, " \t");
+    if (*enable != ':') {
+        return 1;
+    }
+    enable++;
+    enable += strspn(enable, " \t");
+    return strncmp(enable, "false", 5) != 0;
+}
+
+// 处理一条以';'或换行结束的请求
+static void gpsd_request(gpsd_server_t* server, int index, char* request) {
+    gpsd_client_t* client = &server->clients[index];
+    if (strncmp(request, "?VERSION", 8) == 0) {
+        gpsd_reply(server, index, "{\"class\":\"VERSION\",\"release\":\"3.25\",\"rev\":\"nmea0183\","
+                                  "\"proto_major\":3,\"proto_minor\":15}\r\n");
+    } else if (strncmp(request, "?DEVICES", 8) == 0) {
+        gpsd_reply_devices(server, index);
+    } else if (strncmp(request, "?WATCH", 6) == 0) {
+        int watching = gpsd_watch_enabled(request);
+        if (watching && !client->watching) {
+            client->cursor = server->head; // 从下一个历元开始推送
+        }
+        client->watching = watching;
+        if (watching && gpsd_reply_devices(server, index) != 0) {
+            return;
+        }
+        gpsd_reply(server, index, "{\"class\":\"WATCH\",\"enable\":%s,\"json\":true,\"nmea\":false,\"raw\":0,"
+                                  "\"scaled\":false,\"timing\":false,\"split24\":false,\"pps\":false}\r\n",
+                   watching ? "true" : "false");
+    } else {
+        gpsd_reply(server, index, "{\"class\":\"ERROR\",\"message\":\"Unrecognized request '%.32s'\"}\r\n", request);
+    }
+}
+
+static void gpsd_read(gpsd_server_t* server, int index) {
+    gpsd_client_t* client = &server->clients[index];
+    ssize_t n = recv(client->fd, client->request + client->request_len, GPSD_REQUEST_SIZE - 1 - client->request_len,
+                     MSG_DONTWAIT);
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+        gpsd_drop(server, index);
+        return;
+    }
+    if (n < 0) {
+        return;
+    }
+    client->request_len += (uint32_t) n;
+    client->request[client->request_len] = '\0';
+
+    uint32_t start = 0;
+    for (uint32_t i = 0; i < client->request_len && client->fd >= 0; i++) {
+        char c = client->request[i];
+        if (c == ';' || c == '\n' || c == '\r') {
+            client->request[i] = '\0';
+            if (client->request[start] == '?') {
+                gpsd_request(server, index, client->request + start);
+            }
+            start = i + 1;
+        }
+    }
+    if (client->fd < 0) {
+        return;
+    }
+    if (start == 0 && client->request_len == GPSD_REQUEST_SIZE - 1) {
+        start = client->request_len; // 一直没有结束符的超长请求，丢掉
+    }
+    memmove(client->request, client->request + start, client->request_len - start);
+    client->request_len -= start;
+    gpsd_flush(server, index);
+}
+
+static void gpsd_accept(gpsd_server_t* server) {
+    for (;;) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        int index = 0;
+        while (index < GPSD_MAX_CLIENTS && server->clients[index].fd >= 0) {
+            index++;
+        }
+        if (index == GPSD_MAX_CLIENTS || gpsd_watch(server, fd, EPOLLIN, (uint32_t) index, EPOLL_CTL_ADD) != 0) {
+            close(fd);
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        gpsd_client_t* client = &server->clients[index];
+        client->fd = fd;
+        client->watching = 0;
+        client->want_write = 0;
+        client->cursor = server->head;
+        client->reply_len = 0;
+        client->reply_sent = 0;
+        client->request_len = 0;
+        // 和gpsd一样，连上就先发VERSION
+        if (gpsd_reply(server, index, "{\"class\":\"VERSION\",\"release\":\"3.25\",\"rev\":\"nmea0183\","
+                                      "\"proto_major\":3,\"proto_minor\":15}\r\n") == 0) {
+            gpsd_flush(server, index);
+        }
+    }
+}
+
+// 格式化一个历元（TPV，打开卫星解析时再加SKY）并推送给所有WATCH中的客户端
+// 返回：0=成功，-1=空指针，-2=报告超过GPSD_REPORT_SIZE
+int gpsd_server_publish(gpsd_server_t* server, const gps_data_t* data) {
+    if (server == NULL || data == NULL) {
+        return -1;
+    }
+    int len = gps_json_tpv(data, server->device, server->report, sizeof(server->report));
+    if (len < 0) {
+        return -2;
+    }
+#if GPS_ENABLE_SATELLITES
+    int sky = gps_json_sky(data, server->device, server->report + len, sizeof(server->report) - (size_t) len);
+    if (sky < 0) {
+        return -2;
+    }
+    len += sky;
+#endif
+    uint64_t from = server->head;
+    uint64_t to = from + (uint64_t) len;
+
+    // 写入前断开马上要被覆盖、还没发完的客户端；没在WATCH的客户端不收历元
+    for (int i = 0; i < GPSD_MAX_CLIENTS; i++) {
+        gpsd_client_t* client = &server->clients[i];
+        if (client->fd < 0) {
+            continue;
+        }
+        if (!client->watching) {
+            client->cursor = to;
+        } else if (to - client->cursor > GPSD_BACKLOG) {
+            gpsd_drop(server, i);
+            server->dropped++;
+        }
+    }
+
+    size_t start = (size_t) (from & GPSD_MASK);
+    size_t first = GPSD_BACKLOG - start < (size_t) len ? GPSD_BACKLOG - start : (size_t) len;
+    memcpy(server->backlog + start, server->report, first);
+    memcpy(server->backlog, server->report + first, (size_t) len - first);
+    server->head = to;
+    server->epochs++;
+
+    for (int i = 0; i < GPSD_MAX_CLIENTS; i++) {
+        gpsd_client_t* client = &server->clients[i];
+        if (client->fd >= 0 && client->watching && !client->want_write) {
+            gpsd_flush(server, i); // 已经在等EPOLLOUT的客户端由poll补发
+        }
+    }
+    return 0;
+}
+
+// 可以直接传给gps_notify_set_callback，user是gpsd_server_t*
+void gpsd_server_epoch_callback(const gps_data_t* data, uint32_t sequence, void* user) {
+    (void) sequence;
+    gpsd_server_publish((gpsd_server_t*) user, data);
+}
+
+// 处理新连接、客户端请求和可写事件，返回处理的事件数，-1=空指针，-2=epoll_wait失败
+int gpsd_server_poll(gpsd_server_t* server, int timeout_ms) {
+    if (server == NULL) {
+        return -1;
+    }
+    struct epoll_event events[GPSD_EVENTS];
+    int count = epoll_wait(server->epoll_fd, events, GPSD_EVENTS, timeout_ms);
+    if (count < 0) {
+        return errno == EINTR ? 0 : -2;
+    }
+    for (int i = 0; i < count; i++) {
+        uint32_t tag = events[i].data.u32;
+        if (tag == GPSD_TAG_LISTEN) {
+            gpsd_accept(server);
+            continue;
+        }
+        if (server->clients[tag].fd >= 0 && (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+            gpsd_read(server, (int) tag);
+        }
+        if (server->clients[tag].fd >= 0 && (events[i].events & EPOLLOUT)) {
+            gpsd_flush(server, (int) tag);
+        }
+    }
+    return count;
+}
+
+void gpsd_server_close(gpsd_server_t* server) {
+    if (server == NULL) {
+        return;
+    }
+    for (int i = 0; i < GPSD_MAX_CLIENTS; i++) {
+        if (server->clients[i].fd >= 0) {
+            gpsd_drop(server, i);
+        }
+    }
+    if (server->listen_fd >= 0) {
+        close(server->listen_fd);
+        server->listen_fd = -1;
+    }
+    if (server->epoll_fd >= 0) {
+        close(server->epoll_fd);
+        server->epoll_fd = -1;
+    }
+}
+#endif
@@ -0,0 +1,75 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_GPSDSERVER_H
+#define NMEA0183_GPSDSERVER_H
+#include <stddef.h>
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+
+// gpsd JSON协议端点：TPV来自RMC/GGA/VTG/ZDA，SKY来自GSA/GSV卫星表，现有的gpsd客户端（cgps、gpspipe、
+// 各种gpsd库）直接连上来即可，不用再在旁边跑一个完整的gpsd重复解析一遍
+// 每个历元只格式化一次，写进共享的积压缓冲区，所有WATCH中的客户端只记自己发到的位置（和NmeaRelay一样）
+// 支持的请求：?VERSION; ?DEVICES; ?WATCH={...};（只认enable，始终输出json），不支持?POLL
+// 单线程：gpsd_server_publish和gpsd_server_poll都在solve_once所在线程调用
+
+#ifndef GPS_ENABLE_GPSD
+#ifdef __linux__
+#define GPS_ENABLE_GPSD 1
+#else
+#define GPS_ENABLE_GPSD 0
+#endif
+#endif
+
+#define GPSD_DEFAULT_PORT 2947
+#ifndef GPSD_MAX_CLIENTS
+#define GPSD_MAX_CLIENTS 32
+#endif
+#ifndef GPSD_BACKLOG
+#define GPSD_BACKLOG 65536         // 积压缓冲区，必须是2的幂
+#endif
+#define GPSD_REPORT_SIZE 8192      // 一个历元的TPV+SKY
+#define GPSD_REPLY_SIZE 1024       // 每个客户端待发的请求应答
+#define GPSD_REQUEST_SIZE 256      // 每个客户端未处理完的请求
+#define GPSD_EVENTS 32
+
+// 格式化成一行JSON（带\r\n），返回长度，缓冲区不够时返回-2
+int gps_json_tpv(const gps_data_t* data, const char* device, char* out, size_t size);
+#if GPS_ENABLE_SATELLITES
+int gps_json_sky(const gps_data_t* data, const char* device, char* out, size_t size);
+#endif
+
+#if GPS_ENABLE_GPSD
+typedef struct {
+    int fd;                    // -1表示空闲
+    int watching;
+    int want_write;
+    uint64_t cursor;           // 积压缓冲区里发到的位置
+    uint32_t reply_len;
+    uint32_t reply_sent;
+    uint32_t request_len;
+    char reply[GPSD_REPLY_SIZE];
+    char request[GPSD_REQUEST_SIZE];
+} gpsd_client_t;
+
+typedef struct {
+    int epoll_fd;
+    int listen_fd;
+    uint64_t head;
+    uint64_t epochs;           // 发布的历元数
+    uint64_t dropped;          // 因跟不上被断开的客户端
+    char device[64];
+    char backlog[GPSD_BACKLOG];
+    char report[GPSD_REPORT_SIZE];
+    gpsd_client_t clients[GPSD_MAX_CLIENTS];
+} gpsd_server_t;
+
+int gpsd_server_open(gpsd_server_t* server, const char* bind_address, uint16_t port, const char* device);
+int gpsd_server_publish(gpsd_server_t* server, const gps_data_t* data);
+void gpsd_server_epoch_callback(const gps_data_t* data, uint32_t sequence, void* user);
+int gpsd_server_poll(gpsd_server_t* server, int timeout_ms);
+void gpsd_server_close(gpsd_server_t* server);
+#endif
+
+#endif // NMEA0183_GPSDSERVER_H
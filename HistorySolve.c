@@ -0,0 +1,261 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "HistorySolve.h"
+
+#define HISTORY_MASK (GPS_HISTORY_CAPACITY - 1)
+#define HISTORY_MAX_RETRY 8              // 写入端套圈读取端时的最大重试次数
+#define HISTORY_DAY_MS 86400000LL
+#define HISTORY_KNOTS_TO_MS 0.514444444  // 节 -> 米/秒
+#define HISTORY_KMH_TO_MS (1.0 / 3.6)    // 公里/小时 -> 米/秒
+
+_Static_assert((GPS_HISTORY_CAPACITY & HISTORY_MASK) == 0, "GPS_HISTORY_CAPACITY must be a power of two");
+
+int64_t gps_utc_to_unix_ms(int year, int month, int day, int hour, int minute, double second) {
+    return gps_days_from_civil(year, month, day) * HISTORY_DAY_MS +
+           (hour * 3600LL + minute * 60LL) * 1000LL + llround(second * 1000.0);
+}
+
+void gps_history_init(gps_history_t* history) {
+    atomic_init(&history->head, 0);
+    for (int i = 0; i < GPS_HISTORY_CAPACITY; i++) {
+        atomic_init(&history->slots[i].sequence, 0);
+        memset(&history->slots[i].epoch, 0, sizeof(gps_epoch_t));
+    }
+    history->last_time_ms = INT64_MIN;
+    memset(&history->gga_mark, 0, sizeof(gps_tod_mark_t));
+    memset(&history->rmc_mark, 0, sizeof(gps_tod_mark_t));
+}
+
+// 写入一个历元，时间必须严格递增
+int gps_history_push(gps_history_t* history, const gps_epoch_t* epoch) {
+    if (history == NULL || epoch == NULL) {
+        return -1;
+    }
+    if (epoch->time_ms <= history->last_time_ms) {
+        return -2;
+    }
+
+    uint64_t index = atomic_load_explicit(&history->head, memory_order_relaxed);
+    gps_history_slot_t* slot = &history->slots[index & HISTORY_MASK];
+    atomic_store_explicit(&slot->sequence, 2 * index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    slot->epoch = *epoch;
+    atomic_store_explicit(&slot->sequence, 2 * index + 2, memory_order_release);
+    atomic_store_explicit(&history->head, index + 1, memory_order_release);
+
+    history->last_time_ms = epoch->time_ms;
+    return 0;
+}
+
+// 从解析结果中提取紧凑历元，时间用历元的utc_ns（solve_once发布前由gps_epoch_time_update算好）
+// gps_data_t里低频语句会留着旧值：位置取本历元更新过的GGA，没有再取更新过的RMC；速度航向取更新过的RMC，没有再取VTG
+// 返回：0=成功，-1=空指针，-2=没有时间或位置、或者时间没有递增，-4=GGA/RMC都不是新的
+int gps_history_push_epoch(gps_history_t* history, const gps_data_t* data) {
+    if (history == NULL || data == NULL) {
+        return -1;
+    }
+
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    const gps_vtg_t* vtg = gps_data_vtg(data);
+
+    if (!data->has_utc_ns) {
+        return -2;
+    }
+    // 没有时间的语句无法判断新旧，当作新的
+    int gga_fresh = !gga->has_time || gps_tod_mark_advance(&history->gga_mark, gga->hour, gga->minute, gga->second);
+    int rmc_fresh = !rmc->has_time || gps_tod_mark_advance(&history->rmc_mark, rmc->hour, rmc->minute, rmc->second);
+
+    gps_epoch_t epoch = {0};
+    epoch.time_ms = data->utc_ns / 1000000LL;
+    if (gga_fresh && gga->has_latitude && gga->has_longitude) {
+        epoch.latitude_e7 = (int32_t) llround(GPS_TO_DOUBLE(gga->latitude, DEGREE) * 1e7);
+        epoch.longitude_e7 = (int32_t) llround(GPS_TO_DOUBLE(gga->longitude, DEGREE) * 1e7);
+    } else if (rmc_fresh && rmc->has_latitude && rmc->has_longitude) {
+        epoch.latitude_e7 = (int32_t) llround(GPS_TO_DOUBLE(rmc->latitude, DEGREE) * 1e7);
+        epoch.longitude_e7 = (int32_t) llround(GPS_TO_DOUBLE(rmc->longitude, DEGREE) * 1e7);
+    } else if (!gga_fresh && !rmc_fresh) {
+        return -4;
+    } else {
+        return -2;
+    }
+
+    epoch.altitude = gga->has_altitude ? (float) GPS_TO_DOUBLE(gga->altitude, METER) : 0.0f;
+    epoch.fix_quality = gga->has_fix_quality ? (uint8_t) gga->fix_quality : 0;
+    epoch.satellites_used = gga->has_satellites ? (uint8_t) gga->satellites_used : 0;
+    epoch.hdop_centi = gga->has_hdop ? (uint16_t) lround(GPS_TO_DOUBLE(gga->hdop, DOP) * 100.0) : 0;
+
+    epoch.speed = -1.0f;
+    epoch.course = -1.0f;
+    if (rmc_fresh && rmc->has_speed) {
+        epoch.speed = (float) (GPS_TO_DOUBLE(rmc->speed_over_ground, SPEED) * HISTORY_KNOTS_TO_MS);
+    } else if (vtg->has_speed_kmh) {
+        epoch.speed = (float) (GPS_TO_DOUBLE(vtg->speed_kmh, SPEED) * HISTORY_KMH_TO_MS);
+    }
+    if (rmc_fresh && rmc->has_course) {
+        epoch.course = (float) GPS_TO_DOUBLE(rmc->course_over_ground, ANGLE);
+    } else if (vtg->has_true_course) {
+        epoch.course = (float) GPS_TO_DOUBLE(vtg->course_true, ANGLE);
+    }
+
+    return gps_history_push(history, &epoch);
+}
+
+uint64_t gps_history_count(const gps_history_t* history) {
+    uint64_t head = atomic_load_explicit(&history->head, memory_order_acquire);
+    return head < GPS_HISTORY_CAPACITY ? head : GPS_HISTORY_CAPACITY;
+}
+
+// 读取第index个历元，槽位已被覆盖或正在写入时返回0
+static int history_read(const gps_history_t* history, uint64_t index, gps_epoch_t* epoch) {
+    const gps_history_slot_t* slot = &history->slots[index & HISTORY_MASK];
+    uint64_t expected = 2 * index + 2;
+    if (atomic_load_explicit(&slot->sequence, memory_order_acquire) != expected) {
+        return 0;
+    }
+    *epoch = slot->epoch;
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&slot->sequence, memory_order_relaxed) == expected;
+}
+
+int gps_history_latest(const gps_history_t* history, gps_epoch_t* epoch) {
+    if (history == NULL || epoch == NULL) {
+        return -1;
+    }
+    for (int attempt = 0; attempt < HISTORY_MAX_RETRY; attempt++) {
+        uint64_t head = atomic_load_explicit(&history->head, memory_order_acquire);
+        if (head == 0) {
+            return -3;
+        }
+        if (history_read(history, head - 1, epoch)) {
+            return 0;
+        }
+    }
+    return -4;
+}
+
+// 二分查找包围time_ms的两个历元，before.time_ms <= time_ms <= after.time_ms
+// 返回：0=成功，-2=超出历史范围，-3=历史为空，-4=写入过快一直被套圈
+int gps_history_find(const gps_history_t* history, int64_t time_ms, gps_epoch_t* before, gps_epoch_t* after) {
+    if (history == NULL || before == NULL || after == NULL) {
+        return -1;
+    }
+
+    for (int attempt = 0; attempt < HISTORY_MAX_RETRY; attempt++) {
+        uint64_t head = atomic_load_explicit(&history->head, memory_order_acquire);
+        if (head == 0) {
+            return -3;
+        }
+        // 最旧的槽位随时可能被写入端覆盖，跳过它
+        uint64_t lo = head > GPS_HISTORY_CAPACITY ? head - GPS_HISTORY_CAPACITY + 1 : 0;
+        uint64_t hi = head - 1;
+
+        if (!history_read(history, lo, before) || !history_read(history, hi, after)) {
+            continue;
+        }
+        if (time_ms < before->time_ms || time_ms > after->time_ms) {
+            return -2;
+        }
+        if (time_ms == after->time_ms) {
+            *before = *after;
+            return 0;
+        }
+
+        // 不变式：time[lo] <= time_ms < time[hi]
+        int torn = 0;
+        while (hi - lo > 1) {
+            uint64_t mid = lo + (hi - lo) / 2;
+            gps_epoch_t probe;
+            if (!history_read(history, mid, &probe)) {
+                torn = 1;
+                break;
+            }
+            if (probe.time_ms <= time_ms) {
+                lo = mid;
+                *before = probe;
+            } else {
+                hi = mid;
+                *after = probe;
+            }
+        }
+        if (!torn) {
+            return 0;
+        }
+    }
+    return -4;
+}
+
+// 在两个历元之间插值得到time_ms时刻的位置
+int gps_history_interpolate(const gps_history_t* history, int64_t time_ms, int method, gps_epoch_t* epoch) {
+    gps_epoch_t before, after;
+    int ret = gps_history_find(history, time_ms, &before, &after);
+    if (ret != 0) {
+        return ret;
+    }
+    if (before.time_ms == after.time_ms) {
+        *epoch = before;
+        return 0;
+    }
+
+    double f = (double) (time_ms - before.time_ms) / (double) (after.time_ms - before.time_ms);
+    double lat0 = before.latitude_e7 * 1e-7, lon0 = before.longitude_e7 * 1e-7;
+    double lat1 = after.latitude_e7 * 1e-7, lon1 = after.longitude_e7 * 1e-7;
+    double lat, lon;
+
+    if (method == GPS_HISTORY_GREAT_CIRCLE) {
+        // 球面线性插值：单位向量之间按夹角等比例旋转
+        double p0 = lat0 * M_PI / 180.0, l0 = lon0 * M_PI / 180.0;
+        double p1 = lat1 * M_PI / 180.0, l1 = lon1 * M_PI / 180.0;
+        double x0 = cos(p0) * cos(l0), y0 = cos(p0) * sin(l0), z0 = sin(p0);
+        double x1 = cos(p1) * cos(l1), y1 = cos(p1) * sin(l1), z1 = sin(p1);
+        double dot = x0 * x1 + y0 * y1 + z0 * z1;
+        if (dot > 1.0) {
+            dot = 1.0;
+        }
+        double omega = acos(dot);
+        double w0 = 1.0 - f, w1 = f;
+        if (omega > 1e-12) {
+            w0 = sin((1.0 - f) * omega) / sin(omega);
+            w1 = sin(f * omega) / sin(omega);
+        }
+        double x = w0 * x0 + w1 * x1, y = w0 * y0 + w1 * y1, z = w0 * z0 + w1 * z1;
+        lat = atan2(z, sqrt(x * x + y * y)) * 180.0 / M_PI;
+        lon = atan2(y, x) * 180.0 / M_PI;
+    } else {
+        double dlon = lon1 - lon0;
+        if (dlon >= 180.0) {
+            dlon -= 360.0;
+        } else if (dlon < -180.0) {
+            dlon += 360.0;
+        }
+        lat = lat0 + (lat1 - lat0) * f;
+        lon = lon0 + dlon * f;
+        if (lon >= 180.0) {
+            lon -= 360.0;
+        } else if (lon < -180.0) {
+            lon += 360.0;
+        }
+    }
+
+    *epoch = f < 0.5 ? before : after;
+    epoch->time_ms = time_ms;
+    epoch->latitude_e7 = (int32_t) llround(lat * 1e7);
+    epoch->longitude_e7 = (int32_t) llround(lon * 1e7);
+    epoch->altitude = (float) (before.altitude + (after.altitude - before.altitude) * f);
+    if (before.speed >= 0.0f && after.speed >= 0.0f) {
+        epoch->speed = (float) (before.speed + (after.speed - before.speed) * f);
+    }
+    if (before.course >= 0.0f && after.course >= 0.0f) {
+        double dc = after.course - before.course;
+        if (dc >= 180.0) {
+            dc -= 360.0;
+        } else if (dc < -180.0) {
+            dc += 360.0;
+        }
+        double course = before.course + dc * f;
+        epoch->course = (float) (course < 0.0 ? course + 360.0 : (course >= 360.0 ? course - 360.0 : course));
+    }
+    return 0;
+}
@@ -0,0 +1,60 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_HISTORYSOLVE_H
+#define NMEA0183_HISTORYSOLVE_H
+#include <stdatomic.h>
+#include "NMEA0183Solve.h"
+#include "GnssTime.h"
+
+// 按UTC时间索引的历元历史环形缓冲区
+// 单写多读：写入端只有一个，读取端不加锁，每个槽位带序号，读到被覆盖的槽位时自动重试
+
+#ifndef GPS_HISTORY_CAPACITY
+#define GPS_HISTORY_CAPACITY 4096 // 必须是2的幂，10Hz下约可保存6.8分钟
+#endif
+
+#define GPS_HISTORY_LINEAR 0       // 经纬度线性插值
+#define GPS_HISTORY_GREAT_CIRCLE 1 // 大圆插值
+
+// 紧凑历元，32字节
+typedef struct {
+    int64_t time_ms;           // UTC时间（Unix毫秒）
+    int32_t latitude_e7;       // 纬度（1e-7度）
+    int32_t longitude_e7;      // 经度（1e-7度）
+    float altitude;            // 海拔高度（米）
+    float speed;               // 地面速率（米/秒），-1表示无效
+    float course;              // 地面航向（度），-1表示无效
+    uint8_t fix_quality;       // GGA定位质量
+    uint8_t satellites_used;   // 使用卫星数量
+    uint16_t hdop_centi;       // 水平精度因子*100
+} gps_epoch_t;
+
+typedef struct {
+    atomic_uint_fast64_t sequence; // 2*(序号+1)表示写完，奇数表示正在写
+    gps_epoch_t epoch;
+} gps_history_slot_t;
+
+typedef struct {
+    atomic_uint_fast64_t head; // 已写入的历元总数
+    gps_history_slot_t slots[GPS_HISTORY_CAPACITY];
+
+    // 以下只由写入端访问
+    int64_t last_time_ms;
+    gps_tod_mark_t gga_mark;   // 上一次用过的GGA/RMC时刻，旧语句不再当成新历元
+    gps_tod_mark_t rmc_mark;
+} gps_history_t;
+
+void gps_history_init(gps_history_t* history);
+int gps_history_push(gps_history_t* history, const gps_epoch_t* epoch);
+int gps_history_push_epoch(gps_history_t* history, const gps_data_t* data);
+
+uint64_t gps_history_count(const gps_history_t* history);
+int gps_history_latest(const gps_history_t* history, gps_epoch_t* epoch);
+int gps_history_find(const gps_history_t* history, int64_t time_ms, gps_epoch_t* before, gps_epoch_t* after);
+int gps_history_interpolate(const gps_history_t* history, int64_t time_ms, int method, gps_epoch_t* epoch);
+
+int64_t gps_utc_to_unix_ms(int year, int month, int day, int hour, int minute, double second);
+
+#endif // NMEA0183_HISTORYSOLVE_H
@@ -0,0 +1,273 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "KalmanSolve.h"
+
+#define KF_EARTH_RADIUS 6371000.0     // 与calculate_distance保持一致
+#define KF_KNOTS_TO_MS 0.514444444    // 节 -> 米/秒
+#define KF_KMH_TO_MS (1.0 / 3.6)      // 公里/小时 -> 米/秒
+#define KF_RECENTER_DISTANCE 10000.0  // 偏离参考点超过10km后重新选取参考点
+#define KF_INIT_SPEED_SIGMA 30.0      // 初始化时速度的标准差（米/秒）
+
+void gps_kf_default_config(gps_kf_config_t* config) {
+    config->accel_noise = 0.5;
+    config->uere = 4.0;
+    config->speed_sigma = 0.3;
+    config->max_gap = 10.0;
+}
+
+void gps_kf_init(gps_kf_t* kf, const gps_kf_config_t* config) {
+    memset(kf, 0, sizeof(gps_kf_t));
+    if (config != NULL) {
+        kf->config = *config;
+    } else {
+        gps_kf_default_config(&kf->config);
+    }
+}
+
+void gps_kf_reset(gps_kf_t* kf) {
+    gps_kf_config_t config = kf->config;
+    gps_kf_init(kf, &config);
+}
+
+// 设置局部平面参考点
+static void kf_set_reference(gps_kf_t* kf, double latitude, double longitude) {
+    kf->ref_latitude = latitude;
+    kf->ref_longitude = longitude;
+    kf->meters_per_deg_lat = KF_EARTH_RADIUS * M_PI / 180.0;
+    kf->meters_per_deg_lon = kf->meters_per_deg_lat * cos(latitude * M_PI / 180.0);
+}
+
+// 经度差归一化到[-180, 180)
+static double kf_wrap_longitude(double dlon) {
+    if (dlon >= 180.0) {
+        dlon -= 360.0;
+    } else if (dlon < -180.0) {
+        dlon += 360.0;
+    }
+    return dlon;
+}
+
+static void kf_to_local(const gps_kf_t* kf, double latitude, double longitude, double* east, double* north) {
+    *north = (latitude - kf->ref_latitude) * kf->meters_per_deg_lat;
+    *east = kf_wrap_longitude(longitude - kf->ref_longitude) * kf->meters_per_deg_lon;
+}
+
+static void kf_to_geodetic(const gps_kf_t* kf, double east, double north, double* latitude, double* longitude) {
+    *latitude = kf->ref_latitude + north / kf->meters_per_deg_lat;
+    *longitude = kf->ref_longitude + east / kf->meters_per_deg_lon;
+    if (*longitude >= 180.0) {
+        *longitude -= 360.0;
+    } else if (*longitude < -180.0) {
+        *longitude += 360.0;
+    }
+}
+
+// 单轴预测：x = F x, P = F P F' + Q
+static inline void kf_axis_predict(gps_kf_axis_t* a, double dt, double q) {
+    double dt2 = dt * dt;
+    a->pos += a->vel * dt;
+    a->p00 += 2.0 * dt * a->p01 + dt2 * a->p11 + q * dt2 * dt / 3.0;
+    a->p01 += dt * a->p11 + q * dt2 / 2.0;
+    a->p11 += q * dt;
+}
+
+// 单轴位置观测更新
+static inline void kf_axis_update_pos(gps_kf_axis_t* a, double z, double r) {
+    double s = a->p00 + r;
+    double k0 = a->p00 / s;
+    double k1 = a->p01 / s;
+    double y = z - a->pos;
+    a->pos += k0 * y;
+    a->vel += k1 * y;
+    a->p11 -= k1 * a->p01;
+    a->p00 *= 1.0 - k0;
+    a->p01 *= 1.0 - k0;
+}
+
+// 单轴速度观测更新
+static inline void kf_axis_update_vel(gps_kf_axis_t* a, double z, double r) {
+    double s = a->p11 + r;
+    double k0 = a->p01 / s;
+    double k1 = a->p11 / s;
+    double y = z - a->vel;
+    a->pos += k0 * y;
+    a->vel += k1 * y;
+    a->p00 -= k0 * a->p01;
+    a->p01 *= 1.0 - k1;
+    a->p11 *= 1.0 - k1;
+}
+
+// 计算距上次观测的时间间隔，处理跨天
+static double kf_elapsed(const gps_kf_t* kf, double t) {
+    double dt = t - kf->last_time;
+    if (dt < -43200.0) {
+        dt += 86400.0;
+    }
+    return dt;
+}
+
+// 预测到时刻t，时间倒退时不做预测
+static void kf_predict_to(gps_kf_t* kf, double t) {
+    double dt = kf_elapsed(kf, t);
+    if (dt > 0.0) {
+        kf_axis_predict(&kf->east, dt, kf->config.accel_noise);
+        kf_axis_predict(&kf->north, dt, kf->config.accel_noise);
+        kf->last_time = t;
+    }
+}
+
+// 偏离参考点太远时平移参考点，保证平面近似精度
+static void kf_recenter(gps_kf_t* kf) {
+    if (fabs(kf->east.pos) < KF_RECENTER_DISTANCE && fabs(kf->north.pos) < KF_RECENTER_DISTANCE) {
+        return;
+    }
+    double latitude, longitude;
+    kf_to_geodetic(kf, kf->east.pos, kf->north.pos, &latitude, &longitude);
+    kf_set_reference(kf, latitude, longitude);
+    kf->east.pos = 0.0;
+    kf->north.pos = 0.0;
+}
+
+// 刷新对外发布的状态
+static void kf_publish(gps_kf_t* kf) {
+    gps_kf_state_t* s = &kf->state;
+    kf_to_geodetic(kf, kf->east.pos, kf->north.pos, &s->latitude, &s->longitude);
+    s->velocity_east = kf->east.vel;
+    s->velocity_north = kf->north.vel;
+    s->speed = sqrt(kf->east.vel * kf->east.vel + kf->north.vel * kf->north.vel);
+    s->course = atan2(kf->east.vel, kf->north.vel) * 180.0 / M_PI;
+    if (s->course < 0.0) {
+        s->course += 360.0;
+    }
+
+    memset(s->covariance, 0, sizeof(s->covariance));
+    s->covariance[0][0] = kf->east.p00;
+    s->covariance[1][1] = kf->north.p00;
+    s->covariance[2][2] = kf->east.p11;
+    s->covariance[3][3] = kf->north.p11;
+    s->covariance[0][2] = s->covariance[2][0] = kf->east.p01;
+    s->covariance[1][3] = s->covariance[3][1] = kf->north.p01;
+
+    s->utc_seconds = kf->last_time;
+    s->update_count++;
+    s->valid = 1;
+}
+
+// 速度观测（东、北分量）的公共处理
+static int kf_update_velocity(gps_kf_t* kf, int has_time, double t, double speed, double course) {
+    if (!kf->initialized) {
+        return -3;
+    }
+    if (has_time) {
+        if (kf_elapsed(kf, t) > kf->config.max_gap) {
+            return -3; // 太久没有位置观测，等待下一个GGA重新初始化
+        }
+        kf_predict_to(kf, t);
+    }
+
+    double r = kf->config.speed_sigma * kf->config.speed_sigma;
+    double rad = course * M_PI / 180.0;
+    kf_axis_update_vel(&kf->east, speed * sin(rad), r);
+    kf_axis_update_vel(&kf->north, speed * cos(rad), r);
+    kf_publish(kf);
+    return 0;
+}
+
+// 吸收GGA位置，HDOP决定观测噪声
+int gps_kf_update_gga(gps_kf_t* kf, const gps_gga_t* gga) {
+    if (kf == NULL || gga == NULL) {
+        return -1;
+    }
+    if (!gga->has_latitude || !gga->has_longitude || !gga->has_time ||
+        (gga->has_fix_quality && gga->fix_quality == 0)) {
+        return -2;
+    }
+
+    double t = gga->hour * 3600.0 + gga->minute * 60.0 + GPS_TO_DOUBLE(gga->second, SECOND);
+    double hdop = gga->has_hdop ? GPS_TO_DOUBLE(gga->hdop, DOP) : 0.0;
+    if (hdop <= 0.0) {
+        hdop = 99.9;
+    }
+    double sigma = hdop * kf->config.uere;
+    double r = sigma * sigma;
+
+    if (!kf->initialized || kf_elapsed(kf, t) > kf->config.max_gap) {
+        kf_set_reference(kf, GPS_TO_DOUBLE(gga->latitude, DEGREE), GPS_TO_DOUBLE(gga->longitude, DEGREE));
+        kf->east = (gps_kf_axis_t){0.0, 0.0, r, 0.0, KF_INIT_SPEED_SIGMA * KF_INIT_SPEED_SIGMA};
+        kf->north = kf->east;
+        kf->last_time = t;
+        kf->initialized = 1;
+        kf_publish(kf);
+        return 0;
+    }
+
+    kf_predict_to(kf, t);
+    double east, north;
+    kf_to_local(kf, GPS_TO_DOUBLE(gga->latitude, DEGREE), GPS_TO_DOUBLE(gga->longitude, DEGREE), &east, &north);
+    kf_axis_update_pos(&kf->east, east, r);
+    kf_axis_update_pos(&kf->north, north, r);
+    kf_recenter(kf);
+    kf_publish(kf);
+    return 0;
+}
+
+// 吸收RMC的地面速率和航向
+int gps_kf_update_rmc(gps_kf_t* kf, const gps_rmc_t* rmc) {
+    if (kf == NULL || rmc == NULL) {
+        return -1;
+    }
+    if (!rmc->has_speed || !rmc->has_course || (rmc->has_status && rmc->status == 0)) {
+        return -2;
+    }
+
+    double t = rmc->hour * 3600.0 + rmc->minute * 60.0 + GPS_TO_DOUBLE(rmc->second, SECOND);
+    return kf_update_velocity(kf, rmc->has_time, t, GPS_TO_DOUBLE(rmc->speed_over_ground, SPEED) * KF_KNOTS_TO_MS,
+                              GPS_TO_DOUBLE(rmc->course_over_ground, ANGLE));
+}
+
+// 吸收VTG速度，VTG没有时间字段，按最近一次观测时刻处理
+int gps_kf_update_vtg(gps_kf_t* kf, const gps_vtg_t* vtg) {
+    if (kf == NULL || vtg == NULL) {
+        return -1;
+    }
+    if (!vtg->has_true_course || (vtg->has_mode && vtg->mode == 3)) {
+        return -2;
+    }
+
+    double speed;
+    if (vtg->has_speed_kmh) {
+        speed = GPS_TO_DOUBLE(vtg->speed_kmh, SPEED) * KF_KMH_TO_MS;
+    } else if (vtg->has_speed_knots) {
+        speed = GPS_TO_DOUBLE(vtg->speed_knots, SPEED) * KF_KNOTS_TO_MS;
+    } else {
+        return -2;
+    }
+    return kf_update_velocity(kf, 0, 0.0, speed, GPS_TO_DOUBLE(vtg->course_true, ANGLE));
+}
+
+// 吸收一个历元：先GGA位置，再RMC速度；RMC不可用时才用VTG，避免同一速度被重复计入
+// gps_data_t里的语句在历元之间不清空，时刻没有前进的GGA/RMC是上一个历元留下的，再吸收一次就是dt=0、
+// 不做预测的重复观测，协方差会被压向0；VTG没有时刻，只在本历元有新的GGA或RMC时才用
+void gps_kf_update_epoch(gps_kf_t* kf, const gps_data_t* data) {
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    int fresh = 0;
+    if (gga->has_time && gps_tod_mark_advance(&kf->gga_mark, gga->hour, gga->minute, gga->second)) {
+        gps_kf_update_gga(kf, gga);
+        fresh = 1;
+    }
+    int speed_fused = 0;
+    if (rmc->has_time && gps_tod_mark_advance(&kf->rmc_mark, rmc->hour, rmc->minute, rmc->second)) {
+        speed_fused = gps_kf_update_rmc(kf, rmc) == 0;
+        fresh = 1;
+    }
+    if (!speed_fused && fresh) {
+        gps_kf_update_vtg(kf, gps_data_vtg(data));
+    }
+}
+
+const gps_kf_state_t* gps_kf_get_state(const gps_kf_t* kf) {
+    return &kf->state;
+}
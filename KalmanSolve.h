@@ -0,0 +1,77 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_KALMANSOLVE_H
+#define NMEA0183_KALMANSOLVE_H
+#include "NMEA0183Solve.h"
+#include "GnssTime.h"
+
+// 位置/速度卡尔曼滤波器
+// 状态在以参考点为原点的局部东北(EN)平面内表示：[东向位置, 东向速度, 北向位置, 北向速度]
+// 匀速模型下东、北两轴互不耦合，因此拆成两个2x2滤波器，全部手工展开，不使用循环和动态内存
+
+// 滤波器参数
+typedef struct {
+    double accel_noise;        // 过程噪声：加速度功率谱密度（m²/s³）
+    double uere;               // 用户等效测距误差（米），位置观测标准差 = HDOP * uere
+    double speed_sigma;        // 速度观测标准差（米/秒）
+    double max_gap;            // 两次观测最大间隔（秒），超过则重新初始化
+} gps_kf_config_t;
+
+// 单轴状态及协方差（对称矩阵只存上三角）
+typedef struct {
+    double pos;                // 位置（米）
+    double vel;                // 速度（米/秒）
+    double p00;                // 位置方差
+    double p01;                // 位置-速度协方差
+    double p11;                // 速度方差
+} gps_kf_axis_t;
+
+// 对外发布的滤波结果
+typedef struct {
+    double latitude;           // 纬度（度）
+    double longitude;          // 经度（度）
+    double velocity_east;      // 东向速度（米/秒）
+    double velocity_north;     // 北向速度（米/秒）
+    double speed;              // 地面速率（米/秒）
+    double course;             // 地面航向（度，0~360）
+    double covariance[4][4];   // 协方差，顺序为[东向位置, 北向位置, 东向速度, 北向速度]
+    double utc_seconds;        // 最近一次观测的UTC时刻（当天秒数）
+    uint32_t update_count;     // 已吸收的观测次数
+    int valid;                 // 结果是否有效：1=有效，0=尚未初始化
+} gps_kf_state_t;
+
+typedef struct {
+    gps_kf_config_t config;
+
+    // 局部平面参考点
+    double ref_latitude;
+    double ref_longitude;
+    double meters_per_deg_lat;
+    double meters_per_deg_lon;
+
+    gps_kf_axis_t east;
+    gps_kf_axis_t north;
+    double last_time;          // 上次预测到的时刻（当天秒数）
+    int initialized;
+
+    // gps_kf_update_epoch用：上次吸收的GGA、RMC的时刻，时间没前进的旧语句不再重复吸收
+    gps_tod_mark_t gga_mark;
+    gps_tod_mark_t rmc_mark;
+
+    gps_kf_state_t state;
+} gps_kf_t;
+
+void gps_kf_default_config(gps_kf_config_t* config);
+void gps_kf_init(gps_kf_t* kf, const gps_kf_config_t* config);
+void gps_kf_reset(gps_kf_t* kf);
+
+int gps_kf_update_gga(gps_kf_t* kf, const gps_gga_t* gga);
+int gps_kf_update_rmc(gps_kf_t* kf, const gps_rmc_t* rmc);
+int gps_kf_update_vtg(gps_kf_t* kf, const gps_vtg_t* vtg);
+void gps_kf_update_epoch(gps_kf_t* kf, const gps_data_t* data);
+
+const gps_kf_state_t* gps_kf_get_state(const gps_kf_t* kf);
+
+#endif // NMEA0183_KALMANSOLVE_H
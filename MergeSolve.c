@@ -0,0 +1,133 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "MergeSolve.h"
+
+// 返回：0=成功，-1=空指针，-2=来源数不对
+int gps_merge_init(gps_merge_t* merge, int source_count, int64_t lateness_ns) {
+    if (merge == NULL) {
+        return -1;
+    }
+    if (source_count <= 0 || source_count > GPS_MERGE_MAX_SOURCES) {
+        return -2;
+    }
+    memset(merge, 0, sizeof(gps_merge_t));
+    merge->source_count = source_count;
+    merge->lateness_ns = lateness_ns;
+    merge->newest_ns = INT64_MIN;
+    merge->emitted_ns = INT64_MIN;
+    for (int i = 0; i < GPS_MERGE_MAX_SOURCES; i++) {
+        merge->sources[i].last_time_ns = INT64_MIN;
+    }
+    return 0;
+}
+
+static int item_before(const gps_merge_item_t* a, const gps_merge_item_t* b) {
+    return a->time_ns < b->time_ns || (a->time_ns == b->time_ns && (int32_t) (a->sequence - b->sequence) < 0);
+}
+
+// 送入一路的一个历元
+// 返回：0=成功，-1=空指针，-2=来源编号不对或历元没有时间，-3=堆满了，-4=比已经输出的历元还早，丢弃
+int gps_merge_push(gps_merge_t* merge, int source, const gps_data_t* data) {
+    if (merge == NULL || data == NULL) {
+        return -1;
+    }
+    if (source < 0 || source >= merge->source_count) {
+        return -2;
+    }
+    if (!data->has_utc_ns) {
+        return -2;
+    }
+    gps_merge_source_t* src = &merge->sources[source];
+    int64_t time_ns = data->utc_ns;
+    if (time_ns > src->last_time_ns) {
+        src->last_time_ns = time_ns;
+    }
+    if (time_ns > merge->newest_ns) {
+        merge->newest_ns = time_ns;
+    }
+    if (time_ns < merge->emitted_ns) {
+        merge->late_dropped++;
+        return -4;
+    }
+    if (merge->count == GPS_MERGE_CAPACITY) {
+        return -3;
+    }
+
+    // 上浮
+    gps_merge_item_t item = {time_ns, merge->sequence++, source, data};
+    uint32_t i = merge->count++;
+    while (i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if (!item_before(&item, &merge->heap[parent])) {
+            break;
+        }
+        merge->heap[i] = merge->heap[parent];
+        i = parent;
+    }
+    merge->heap[i] = item;
+    return 0;
+}
+
+static void heap_pop(gps_merge_t* merge, gps_merge_item_t* item) {
+    *item = merge->heap[0];
+    gps_merge_item_t last = merge->heap[--merge->count];
+    // 下沉
+    uint32_t i = 0;
+    for (;;) {
+        uint32_t child = 2 * i + 1;
+        if (child >= merge->count) {
+            break;
+        }
+        if (child + 1 < merge->count && item_before(&merge->heap[child + 1], &merge->heap[child])) {
+            child++;
+        }
+        if (!item_before(&merge->heap[child], &last)) {
+            break;
+        }
+        merge->heap[i] = merge->heap[child];
+        i = child;
+    }
+    merge->heap[i] = last;
+    merge->emitted_ns = item->time_ns;
+}
+
+// 取出下一个可以按顺序输出的历元：所有来源都已经到了这个时刻，或者最新的数据已经比它晚了lateness_ns
+// 返回：1=取出一个，0=现在没有可以输出的，-1=空指针
+int gps_merge_pop(gps_merge_t* merge, gps_merge_item_t* item) {
+    if (merge == NULL || item == NULL) {
+        return -1;
+    }
+    if (merge->count == 0) {
+        return 0;
+    }
+    int64_t head_ns = merge->heap[0].time_ns;
+    int ready = merge->newest_ns - head_ns >= merge->lateness_ns;
+    if (!ready) {
+        ready = 1;
+        for (int i = 0; i < merge->source_count; i++) {
+            if (merge->sources[i].last_time_ns < head_ns) {
+                ready = 0;
+                break;
+            }
+        }
+    }
+    if (!ready) {
+        return 0;
+    }
+    heap_pop(merge, item);
+    return 1;
+}
+
+// 不再等待，按时间顺序取出剩下的历元（数据流结束时用）
+int gps_merge_flush(gps_merge_t* merge, gps_merge_item_t* item) {
+    if (merge == NULL || item == NULL) {
+        return -1;
+    }
+    if (merge->count == 0) {
+        return 0;
+    }
+    heap_pop(merge, item);
+    return 1;
+}
@@ -0,0 +1,49 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_MERGESOLVE_H
+#define NMEA0183_MERGESOLVE_H
+#include "NMEA0183Solve.h"
+
+// 多接收机按UTC时间归并：各路解析好的历元放进最小堆，按时间先后输出
+// 所有来源都已经送到某个时刻之后（还没有数据的来源也要等），这个时刻之前的历元立即输出；有来源掉线或落后时最多再等lateness_ns
+// 堆里只存指针，不复制gps_data_t，调用方要保证历元在弹出之前一直有效（比如每路用几个缓冲区轮换）
+// 时间用历元的utc_ns（solve_once发布前由gps_epoch_time_update算好，自己拼的历元要先调用它），没有utc_ns的历元不收
+
+#ifndef GPS_MERGE_MAX_SOURCES
+#define GPS_MERGE_MAX_SOURCES 8
+#endif
+#ifndef GPS_MERGE_CAPACITY
+#define GPS_MERGE_CAPACITY 64      // 堆里最多同时等待的历元数
+#endif
+
+typedef struct {
+    int64_t time_ns;           // UTC时间（Unix纳秒），即data->utc_ns
+    uint32_t sequence;         // 送入顺序，同一时刻的历元按先来后到输出
+    int source;                // 来源编号
+    const gps_data_t* data;
+} gps_merge_item_t;
+
+typedef struct {
+    int64_t last_time_ns;      // 最近一个历元的时间，INT64_MIN表示还没有数据
+} gps_merge_source_t;
+
+typedef struct {
+    gps_merge_item_t heap[GPS_MERGE_CAPACITY];
+    uint32_t count;
+    uint32_t sequence;
+    int source_count;          // 来源编号0~source_count-1
+    int64_t lateness_ns;
+    int64_t newest_ns;         // 见过的最新时间
+    int64_t emitted_ns;        // 最近输出的时间，比它早的历元来了也不能再按顺序输出
+    uint64_t late_dropped;     // 因为来得太晚被丢弃的历元数
+    gps_merge_source_t sources[GPS_MERGE_MAX_SOURCES];
+} gps_merge_t;
+
+int gps_merge_init(gps_merge_t* merge, int source_count, int64_t lateness_ns);
+int gps_merge_push(gps_merge_t* merge, int source, const gps_data_t* data);
+int gps_merge_pop(gps_merge_t* merge, gps_merge_item_t* item);
+int gps_merge_flush(gps_merge_t* merge, gps_merge_item_t* item);
+
+#endif // NMEA0183_MERGESOLVE_H
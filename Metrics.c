@@ -0,0 +1,191 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "Metrics.h"
+#include <string.h>
+
+static const char* const talker_names[GPS_TALKER_COUNT] = {"GP", "GL", "GA", "GB", "GQ", "GN", "OTHER"};
+static const char* const sentence_type_names[GPS_SENTENCE_TYPE_COUNT] = {
+    "GGA", "GLL", "GSA", "GSV", "RMC", "VTG", "ZDA", "TXT", "OTHER"};
+static const char* const stage_names[GPS_STAGE_COUNT] = {"queue", "publish_wait", "epoch", "receiver", "end_to_end"};
+
+#if GPS_ENABLE_METRICS
+typedef struct {
+    atomic_uint_fast64_t sentences[GPS_TALKER_COUNT][GPS_SENTENCE_TYPE_COUNT][GPS_OUTCOME_COUNT];
+    atomic_uint_fast64_t epochs;
+    atomic_uint_fast64_t unframed_bytes;
+    atomic_uint_fast64_t frames[GPS_PROTOCOL_COUNT];
+    atomic_uint_fast64_t frame_errors[GPS_PROTOCOL_COUNT];
+    atomic_uint_fast64_t cache_hits;
+    gps_histogram_live_t parse_time;
+    gps_histogram_live_t publish_age;
+    gps_histogram_live_t stages[GPS_STAGE_COUNT];
+    atomic_uint_fast64_t stage_negative[GPS_STAGE_COUNT];
+} gps_metrics_live_t;
+
+static gps_metrics_live_t metrics;
+
+// 只有解析线程写入，用load+store代替fetch_add即可
+static inline void metrics_inc(atomic_uint_fast64_t* counter, uint64_t value) {
+    atomic_store_explicit(counter, atomic_load_explicit(counter, memory_order_relaxed) + value,
+                          memory_order_relaxed);
+}
+
+static void histogram_observe(gps_histogram_live_t* h, uint64_t ns) {
+    int bucket = ns == 0 ? 0 : 63 - __builtin_clzll(ns);
+    if (bucket >= GPS_HISTOGRAM_BUCKETS) {
+        bucket = GPS_HISTOGRAM_BUCKETS - 1;
+    }
+    metrics_inc(&h->buckets[bucket], 1);
+    metrics_inc(&h->count, 1);
+    metrics_inc(&h->sum, ns);
+    if (ns > atomic_load_explicit(&h->max, memory_order_relaxed)) {
+        atomic_store_explicit(&h->max, ns, memory_order_relaxed);
+    }
+}
+
+static void histogram_snapshot(gps_histogram_live_t* h, gps_histogram_t* out) {
+    out->count = atomic_load_explicit(&h->count, memory_order_relaxed);
+    out->sum = atomic_load_explicit(&h->sum, memory_order_relaxed);
+    out->max = atomic_load_explicit(&h->max, memory_order_relaxed);
+    for (int i = 0; i < GPS_HISTOGRAM_BUCKETS; i++) {
+        out->buckets[i] = atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+    }
+}
+#endif
+
+// 由语句头"$GPxxx"得到发送者编号
+int gps_talker_index(const char* sentence) {
+    char a = sentence[1], b = a != '\0' ? sentence[2] : '\0';
+    if (a == 'G') {
+        switch (b) {
+            case 'P': return GPS_TALKER_GP;
+            case 'L': return GPS_TALKER_GL;
+            case 'A': return GPS_TALKER_GA;
+            case 'B': return GPS_TALKER_GB;
+            case 'Q': return GPS_TALKER_GQ;
+            case 'N': return GPS_TALKER_GN;
+            default: break;
+        }
+    } else if (a == 'B' && b == 'D') {
+        return GPS_TALKER_GB;
+    }
+    return GPS_TALKER_OTHER;
+}
+
+// 由语句头"$xxGGA"得到语句类型编号
+int gps_sentence_type_index(const char* sentence) {
+    for (int i = 0; i < 6; i++) { // 不用strlen，只看前7个字符
+        if (sentence[i] == '\0') {
+            return GPS_SENTENCE_OTHER;
+        }
+    }
+    if (sentence[6] != ',') {
+        return GPS_SENTENCE_OTHER;
+    }
+    for (int i = 0; i < GPS_SENTENCE_OTHER; i++) {
+        if (strncmp(sentence + 3, sentence_type_names[i], 3) == 0) {
+            return i;
+        }
+    }
+    return GPS_SENTENCE_OTHER;
+}
+
+const char* gps_talker_name(int talker) {
+    return talker >= 0 && talker < GPS_TALKER_COUNT ? talker_names[talker] : "?";
+}
+
+const char* gps_sentence_type_name(int type) {
+    return type >= 0 && type < GPS_SENTENCE_TYPE_COUNT ? sentence_type_names[type] : "?";
+}
+
+const char* gps_stage_name(int stage) {
+    return stage >= 0 && stage < GPS_STAGE_COUNT ? stage_names[stage] : "?";
+}
+
+// 直方图的分位数（fraction取0~1），返回所在桶的上界，也就是“不超过这个值”的保守估计
+uint64_t gps_histogram_percentile(const gps_histogram_t* histogram, double fraction) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t) (fraction * (double) histogram->count + 0.5);
+    uint64_t seen = 0;
+    for (int i = 0; i < GPS_HISTOGRAM_BUCKETS - 1; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= target) {
+            uint64_t upper = 2ull << i;
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+#if GPS_ENABLE_METRICS
+void gps_metrics_count(int talker, int type, int outcome) {
+    metrics_inc(&metrics.sentences[talker][type][outcome], 1);
+}
+
+void gps_metrics_add_epoch(void) {
+    metrics_inc(&metrics.epochs, 1);
+}
+
+void gps_metrics_add_unframed(uint64_t bytes) {
+    metrics_inc(&metrics.unframed_bytes, bytes);
+}
+
+void gps_metrics_count_frame(int protocol, int ok) {
+    metrics_inc(ok ? &metrics.frames[protocol] : &metrics.frame_errors[protocol], 1);
+}
+
+void gps_metrics_add_cache_hit(void) {
+    metrics_inc(&metrics.cache_hits, 1);
+}
+
+void gps_metrics_observe_parse(uint64_t ns) {
+    histogram_observe(&metrics.parse_time, ns);
+}
+
+void gps_metrics_observe_publish_age(uint64_t ns) {
+    histogram_observe(&metrics.publish_age, ns);
+}
+
+void gps_metrics_observe_stage(int stage, int64_t ns) {
+    if (ns < 0) {
+        metrics_inc(&metrics.stage_negative[stage], 1);
+        return;
+    }
+    histogram_observe(&metrics.stages[stage], (uint64_t) ns);
+}
+
+// 读取快照，可在任意线程调用；各计数分别是原子的，但快照整体不保证是同一时刻
+void gps_metrics_snapshot(gps_metrics_snapshot_t* snapshot) {
+    memset(snapshot, 0, sizeof(gps_metrics_snapshot_t));
+    for (int t = 0; t < GPS_TALKER_COUNT; t++) {
+        for (int s = 0; s < GPS_SENTENCE_TYPE_COUNT; s++) {
+            for (int o = 0; o < GPS_OUTCOME_COUNT; o++) {
+                snapshot->sentences[t][s].outcomes[o] =
+                        atomic_load_explicit(&metrics.sentences[t][s][o], memory_order_relaxed);
+            }
+        }
+    }
+    snapshot->epochs = atomic_load_explicit(&metrics.epochs, memory_order_relaxed);
+    snapshot->unframed_bytes = atomic_load_explicit(&metrics.unframed_bytes, memory_order_relaxed);
+    for (int p = 0; p < GPS_PROTOCOL_COUNT; p++) {
+        snapshot->frames[p] = atomic_load_explicit(&metrics.frames[p], memory_order_relaxed);
+        snapshot->frame_errors[p] = atomic_load_explicit(&metrics.frame_errors[p], memory_order_relaxed);
+    }
+    snapshot->cache_hits = atomic_load_explicit(&metrics.cache_hits, memory_order_relaxed);
+    histogram_snapshot(&metrics.parse_time, &snapshot->parse_time);
+    histogram_snapshot(&metrics.publish_age, &snapshot->publish_age);
+    for (int i = 0; i < GPS_STAGE_COUNT; i++) {
+        histogram_snapshot(&metrics.stages[i], &snapshot->stages[i]);
+        snapshot->stage_negative[i] = atomic_load_explicit(&metrics.stage_negative[i], memory_order_relaxed);
+    }
+}
+#else
+// 关掉统计时计数器和直方图都不编译，快照全是0
+void gps_metrics_snapshot(gps_metrics_snapshot_t* snapshot) {
+    memset(snapshot, 0, sizeof(gps_metrics_snapshot_t));
+}
+#endif
@@ -0,0 +1,130 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_METRICS_H
+#define NMEA0183_METRICS_H
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>
+#include "GPSConfig.h"
+#include "RingBuffer.h"
+#include "StreamDemux.h"
+
+// 运行时统计：按发送者(talker)和语句类型计数，以及按2的幂分桶的耗时直方图
+// 只有解析线程写入计数，其它线程通过快照读取，计数用relaxed原子变量，不使用带锁前缀的读改写指令
+
+#ifndef GPS_ENABLE_METRICS
+#define GPS_ENABLE_METRICS 1
+#endif
+
+// 发送者编号
+#define GPS_TALKER_GP 0        // GPS
+#define GPS_TALKER_GL 1        // GLONASS
+#define GPS_TALKER_GA 2        // Galileo
+#define GPS_TALKER_GB 3        // 北斗（GB/BD）
+#define GPS_TALKER_GQ 4        // QZSS
+#define GPS_TALKER_GN 5        // 多系统联合
+#define GPS_TALKER_OTHER 6
+#define GPS_TALKER_COUNT 7
+
+// 语句类型编号
+#define GPS_SENTENCE_GGA 0
+#define GPS_SENTENCE_GLL 1
+#define GPS_SENTENCE_GSA 2
+#define GPS_SENTENCE_GSV 3
+#define GPS_SENTENCE_RMC 4
+#define GPS_SENTENCE_VTG 5
+#define GPS_SENTENCE_ZDA 6
+#define GPS_SENTENCE_TXT 7
+#define GPS_SENTENCE_OTHER 8
+#define GPS_SENTENCE_TYPE_COUNT 9
+
+// 语句处理结果
+#define GPS_OUTCOME_PARSED 0          // 解析成功
+#define GPS_OUTCOME_REJECTED 1        // 格式不对或不支持
+#define GPS_OUTCOME_CHECKSUM_FAILED 2 // 校验和错误
+#define GPS_OUTCOME_TRUNCATED 3       // 语句不完整（没有校验和或过长）
+#define GPS_OUTCOME_DROPPED 4         // 卫星表已满等原因被丢弃
+#define GPS_OUTCOME_COUNT 5
+
+// 延迟分段（每个历元记录一次，接收机相关的两段需要系统时钟已经对准，比如由TimeService+chrony校准）
+#define GPS_STAGE_QUEUE 0             // 语句到达 -> 分帧（在环形缓冲区和分帧缓冲区里等待）
+#define GPS_STAGE_PUBLISH_WAIT 1      // 语句解析完 -> 随历元发布
+#define GPS_STAGE_EPOCH 2             // 历元第一个字节到达 -> 发布
+#define GPS_STAGE_RECEIVER 3          // 接收机UTC时间标签 -> 历元第一个字节到达（接收机输出延迟+串口传输）
+#define GPS_STAGE_END_TO_END 4        // 接收机UTC时间标签 -> 发布
+#define GPS_STAGE_COUNT 5
+
+#define GPS_HISTOGRAM_BUCKETS 40      // 第i个桶统计[2^i, 2^(i+1))纳秒，最后一个桶包含更大的值
+
+typedef struct {
+    uint64_t outcomes[GPS_OUTCOME_COUNT];
+} gps_sentence_counters_t;
+
+typedef struct {
+    uint64_t count;
+    uint64_t sum;              // 总和（纳秒）
+    uint64_t max;              // 最大值（纳秒）
+    uint64_t buckets[GPS_HISTOGRAM_BUCKETS];
+} gps_histogram_t;
+
+typedef struct {
+    gps_sentence_counters_t sentences[GPS_TALKER_COUNT][GPS_SENTENCE_TYPE_COUNT];
+    uint64_t epochs;           // solve_once发布次数
+    uint64_t unframed_bytes;   // 找不到换行或与前面数据不连续而丢弃的字节数
+    uint64_t frames[GPS_PROTOCOL_COUNT];       // 分帧得到的帧数（按协议）
+    uint64_t frame_errors[GPS_PROTOCOL_COUNT]; // 长度对但校验失败的二进制帧（NMEA的校验和错误按语句计）
+    uint64_t cache_hits;       // 命中解析缓存、没有重新解析的语句数（GPS_ENABLE_PARSE_CACHE）
+    gps_ring_stats_t ring;     // 环形缓冲区统计（含溢出丢弃）
+    gps_histogram_t parse_time;   // 单条语句解析耗时
+    gps_histogram_t publish_age;  // 语句到达到随历元发布的时间
+    gps_histogram_t stages[GPS_STAGE_COUNT]; // 分段延迟
+    uint64_t stage_negative[GPS_STAGE_COUNT]; // 算出负值（系统时钟比接收机快）而没有计入直方图的次数
+} gps_metrics_snapshot_t;
+
+typedef struct {
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t sum;
+    atomic_uint_fast64_t max;
+    atomic_uint_fast64_t buckets[GPS_HISTOGRAM_BUCKETS];
+} gps_histogram_live_t;
+
+// 系统时间（Unix纪元纳秒）
+static inline int64_t gps_realtime_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// 单调时钟（纳秒）
+static inline uint64_t gps_monotonic_ns(void) {
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+int gps_talker_index(const char* sentence);
+int gps_sentence_type_index(const char* sentence);
+const char* gps_talker_name(int talker);
+const char* gps_sentence_type_name(int type);
+const char* gps_stage_name(int stage);
+uint64_t gps_histogram_percentile(const gps_histogram_t* histogram, double fraction);
+
+#if GPS_ENABLE_METRICS
+void gps_metrics_count(int talker, int type, int outcome);
+void gps_metrics_add_epoch(void);
+void gps_metrics_add_unframed(uint64_t bytes);
+void gps_metrics_add_cache_hit(void);
+void gps_metrics_count_frame(int protocol, int ok);
+void gps_metrics_observe_parse(uint64_t ns);
+void gps_metrics_observe_publish_age(uint64_t ns);
+void gps_metrics_observe_stage(int stage, int64_t ns);
+#endif
+void gps_metrics_snapshot(gps_metrics_snapshot_t* snapshot);
+
+#endif // NMEA0183_METRICS_H
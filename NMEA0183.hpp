@@ -0,0 +1,378 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_NMEA0183_HPP
+#define NMEA0183_NMEA0183_HPP
+
+// C++17 头文件封装：直接调用C的逐条解析函数（parse_gpgga等，都是无状态的），不经过GPSSolve.c的全局变量
+//   nmea0183::parse(line)            -> std::variant<Status, Gga, Gll, Gsa, Gsv, Rmc, Vtg, Zda>
+//   nmea0183::parse(line, visitor)   按语句类型直接调用visitor(const Gga&)等，visitor只需实现关心的类型
+//   nmea0183::Parser                 自己持有分帧缓冲区和历元数据，按历元聚合，语义和add_bytes+solve_once一样；
+//                                    每个线程各用一个，不需要加锁
+// 全程不分配内存：string_view不保证以'\0'结尾，复制到栈上/对象内的定长缓冲区再交给C函数
+// 结果类型就是C结构体，可以平凡复制，放进variant、容器都只是memcpy
+// 需要链接NMEA0183Solve.c、SatelliteSolve.c、FixedPoint.c、GnssTime.c
+
+// C++的<math.h>等包装头不能放进extern "C"，先在外面包含，下面C头文件里再包含时什么也不做
+#include <ctype.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+extern "C" {
+#include "NMEA0183Solve.h"
+#include "GnssTime.h"
+}
+
+namespace nmea0183 {
+
+using Gga = gps_gga_t;
+using Gll = gps_gll_t;
+using Gsa = gps_gsa_t;
+using Gsv = gps_gsv_t;
+using Rmc = gps_rmc_t;
+using Vtg = gps_vtg_t;
+using Zda = gps_zda_t;
+using Epoch = gps_data_t;
+
+// 和Metrics.h的GPS_OUTCOME_xxx一一对应
+enum class Status : int {
+    parsed = 0,          // 解析成功；TXT等校验通过但没有内容可解的语句也算
+    rejected = 1,        // 格式不对或这种语句没编译进来
+    checksum_failed = 2,
+    truncated = 3,       // 没有校验和或超过NMEA_MAX_SENTENCE
+    dropped = 4,         // 卫星表已满
+};
+
+using Sentence = std::variant<Status, Gga, Gll, Gsa, Gsv, Rmc, Vtg, Zda>;
+
+// 和Metrics.h的GPS_SENTENCE_xxx编号相同
+enum class Type : int { gga = 0, gll, gsa, gsv, rmc, vtg, zda, txt, other };
+
+// 看"$xxYYY,"里的YYY，和gps_sentence_type_index一样
+constexpr Type classify(std::string_view sentence) noexcept {
+    if (sentence.size() < 7 || sentence[6] != ',') {
+        return Type::other;
+    }
+    constexpr std::string_view names[] = {"GGA", "GLL", "GSA", "GSV", "RMC", "VTG", "ZDA", "TXT"};
+    std::string_view name = sentence.substr(3, 3);
+    for (int i = 0; i < static_cast<int>(Type::other); i++) {
+        if (name == names[i]) {
+            return static_cast<Type>(i);
+        }
+    }
+    return Type::other;
+}
+
+namespace detail {
+
+constexpr std::size_t line_capacity = NMEA_MAX_SENTENCE + 8; // 加上'$'、校验和、'\0'
+
+// 去掉行尾，复制成以'\0'结尾的字符串
+inline bool terminate(std::string_view line, char* out) noexcept {
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+        line.remove_suffix(1);
+    }
+    if (line.size() >= line_capacity) {
+        return false;
+    }
+    std::memcpy(out, line.data(), line.size());
+    out[line.size()] = '\0';
+    return true;
+}
+
+inline Status outcome(int ret) noexcept {
+    if (ret == 0) {
+        return Status::parsed;
+    }
+    return ret == -3 || ret == -4 ? Status::truncated : Status::rejected;
+}
+
+// visitor没有实现这个类型就什么也不做，不会退化成虚调用或类型擦除
+template <class T, class Visitor>
+inline void deliver(Visitor& visitor, const T& record) {
+    if constexpr (std::is_invocable_v<Visitor&, const T&>) {
+        visitor(record);
+    }
+}
+
+template <class T, class Visitor>
+inline Status parse_into(int (*parse)(const char*, T*), const char* sentence, T& record, Visitor& visitor) {
+    Status status = outcome(parse(sentence, &record));
+    if (status == Status::parsed) {
+        deliver(visitor, record);
+    }
+    return status;
+}
+
+} // namespace detail
+
+// 解析一条以'\0'结尾、'$'开头的语句，结果写进栈上的临时记录再交给visitor
+template <class Visitor>
+inline Status parse_terminated(const char* sentence, Visitor&& visitor) {
+    int ret = nmea_verify_checksum(sentence);
+    if (ret != 0) {
+        return ret == -3 ? Status::truncated : Status::checksum_failed;
+    }
+    switch (classify(std::string_view(sentence, ::strnlen(sentence, 7)))) {
+#if GPS_ENABLE_GGA
+        case Type::gga: {
+            Gga record{};
+            return detail::parse_into(parse_gpgga, sentence, record, visitor);
+        }
+#endif
+#if GPS_ENABLE_GLL
+        case Type::gll: {
+            Gll record{};
+            return detail::parse_into(parse_gpgll, sentence, record, visitor);
+        }
+#endif
+#if GPS_ENABLE_GSA
+        case Type::gsa: {
+            Gsa record{};
+            return detail::parse_into(parse_gpgsa, sentence, record, visitor);
+        }
+#endif
+#if GPS_ENABLE_GSV
+        case Type::gsv: {
+            Gsv record{};
+            return detail::parse_into(parse_gpgsv_single, sentence, record, visitor);
+        }
+#endif
+#if GPS_ENABLE_RMC
+        case Type::rmc: {
+            Rmc record{};
+            return detail::parse_into(parse_gprmc, sentence, record, visitor);
+        }
+#endif
+#if GPS_ENABLE_VTG
+        case Type::vtg: {
+            Vtg record{};
+            return detail::parse_into(parse_gpvtg, sentence, record, visitor);
+        }
+#endif
+#if GPS_ENABLE_ZDA
+        case Type::zda: {
+            Zda record{};
+            return detail::parse_into(parse_gpzda, sentence, record, visitor);
+        }
+#endif
+        case Type::txt:
+            return Status::parsed;
+        default:
+            return Status::rejected;
+    }
+}
+
+// 解析一行（可以带"\r\n"），成功时按类型调用visitor
+template <class Visitor>
+inline Status parse(std::string_view line, Visitor&& visitor) {
+    char sentence[detail::line_capacity];
+    if (!detail::terminate(line, sentence)) {
+        return Status::truncated;
+    }
+    return parse_terminated(sentence, visitor);
+}
+
+inline Sentence parse(std::string_view line) {
+    Sentence result{Status::parsed};
+    Status status = parse(line, [&result](const auto& record) { result = record; });
+    if (status != Status::parsed) {
+        result = status;
+    }
+    return result;
+}
+
+// 持有自己的分帧缓冲区和历元数据的解析器
+// feed()可以喂任意切分的字节流，publish()结束当前历元，和solve_once一样把预览数据复制成快照并重置卫星表的位置；
+// 两者之间调用snapshot()看到的是上一个历元
+// 分帧规则和add_bytes+solve_once（StreamDemux.c的NMEA部分加GPSSolve.c）相同，同一段数据两边的快照和统计一致：
+//   '$'或'!'开始一行，行中间再出现起始符时从那里重新开始，前面的半行作废不计数；
+//   遇到'\r'以外的控制字符或非ASCII字节整行作废；'\n'结束一行，去掉紧挨着的一个'\r'；
+//   不到7个字节（"$xxYYY,"）的行当作噪声丢掉，不计数
+// 超出行缓冲区的部分不保存，校验和在前面的话照样解析；C引擎那边超过解析缓冲区（BUFF_SIZE）的行整行丢掉，
+// 只有这种超长行两边结果不同
+class Parser {
+public:
+    struct Counters {
+        uint64_t outcomes[5];  // 按Status计数
+        uint64_t epochs;
+    };
+
+    Parser() noexcept {
+        reset();
+    }
+
+    void reset() noexcept {
+        std::memset(&preview_, 0, sizeof(preview_));
+        std::memset(&published_, 0, sizeof(published_));
+        std::memset(&day_, 0, sizeof(day_));
+        std::memset(&counters_, 0, sizeof(counters_));
+        line_len_ = 0;
+        last_ = '\0';
+        in_line_ = false;
+        begin_epoch();
+    }
+
+    // 返回这次解析的行数（计入counters()的行）
+    template <class Visitor>
+    std::size_t feed(std::string_view bytes, Visitor&& visitor) {
+        std::size_t lines = 0;
+        for (char ch : bytes) {
+            unsigned char c = static_cast<unsigned char>(ch);
+            if (c == '$' || c == '!') {
+                line_[0] = ch;
+                line_len_ = 1;
+                in_line_ = true;
+            } else if (!in_line_) {
+                continue;
+            } else if (c == '\n') {
+                in_line_ = false;
+                lines += consume(visitor);
+                continue;
+            } else if ((c < 0x20 || c > 0x7E) && c != '\r') {
+                in_line_ = false;
+                continue;
+            } else {
+                if (line_len_ < detail::line_capacity - 1) {
+                    line_[line_len_] = ch;
+                }
+                line_len_++;
+            }
+            last_ = ch;
+        }
+        return lines;
+    }
+
+    std::size_t feed(std::string_view bytes) {
+        return feed(bytes, [](const auto&) {});
+    }
+
+    // 结束当前历元：算UTC时间，复制成快照
+    const Epoch& publish() noexcept {
+        gps_epoch_time_update(&preview_, &day_);
+        published_ = preview_;
+        counters_.epochs++;
+        begin_epoch();
+        return published_;
+    }
+
+    // 上一个历元的结果，不复制
+    const Epoch& snapshot() const noexcept {
+        return published_;
+    }
+
+    const Counters& counters() const noexcept {
+        return counters_;
+    }
+
+private:
+    // 一行收完，返回是否计数
+    template <class Visitor>
+    std::size_t consume(Visitor& visitor) {
+        std::size_t length = line_len_ > 1 && last_ == '\r' ? line_len_ - 1 : line_len_;
+        if (length < 7) {
+            return 0;
+        }
+        line_[length < detail::line_capacity - 1 ? length : detail::line_capacity - 1] = '\0';
+        Status status = dispatch(line_, visitor);
+        counters_.outcomes[static_cast<int>(status)]++;
+        return 1;
+    }
+
+    // 和GPSSolve.c的solve_sentence一样：解析结果直接写进历元里对应的位置，再把这个位置交给visitor
+    template <class Visitor>
+    Status dispatch(const char* sentence, Visitor& visitor) {
+        int ret = nmea_verify_checksum(sentence);
+        if (ret != 0) {
+            return ret == -3 ? Status::truncated : Status::checksum_failed;
+        }
+        switch (classify(std::string_view(sentence, ::strnlen(sentence, 7)))) {
+#if GPS_ENABLE_GGA
+            case Type::gga:
+                return detail::parse_into(parse_gpgga, sentence, preview_.gga, visitor);
+#endif
+#if GPS_ENABLE_GLL
+            case Type::gll:
+                return detail::parse_into(parse_gpgll, sentence, preview_.gll, visitor);
+#endif
+#if GPS_ENABLE_GSA
+            case Type::gsa: {
+                if (gsa_pointer_ >= MAX_KIND_OF_SATELLITE) {
+                    return Status::dropped;
+                }
+                Gsa& slot = preview_.satellites.gsa[gsa_pointer_++];
+                return detail::parse_into(parse_gpgsa, sentence, slot, visitor);
+            }
+#endif
+#if GPS_ENABLE_GSV
+            case Type::gsv: {
+                if (std::memcmp(sentence + 1, last_gsv_system_, 2) == 0) {
+                    gsv_child_pointer_++;
+                } else {
+                    gsv_pointer_++;
+                    gsv_child_pointer_ = 0;
+                }
+                std::memcpy(last_gsv_system_, sentence + 1, 2);
+                if (gsv_pointer_ >= MAX_KIND_OF_SATELLITE || gsv_child_pointer_ >= EACH_KIND_OF_SATELLITE) {
+                    return Status::dropped;
+                }
+                Gsv& slot = preview_.satellites.gsv[gsv_pointer_][gsv_child_pointer_];
+                return detail::parse_into(parse_gpgsv_single, sentence, slot, visitor);
+            }
+#endif
+#if GPS_ENABLE_RMC
+            case Type::rmc:
+                return detail::parse_into(parse_gprmc, sentence, preview_.rmc, visitor);
+#endif
+#if GPS_ENABLE_VTG
+            case Type::vtg:
+                return detail::parse_into(parse_gpvtg, sentence, preview_.vtg, visitor);
+#endif
+#if GPS_ENABLE_ZDA
+            case Type::zda:
+                return detail::parse_into(parse_gpzda, sentence, preview_.zda, visitor);
+#endif
+            case Type::txt:
+                return Status::parsed;
+            default:
+                return Status::rejected;
+        }
+    }
+
+    void begin_epoch() noexcept {
+        gsa_pointer_ = 0;
+        last_gsv_system_[0] = '0';
+        last_gsv_system_[1] = '0';
+        gsv_pointer_ = -1;
+        gsv_child_pointer_ = 0;
+    }
+
+    Epoch preview_;
+    Epoch published_;
+    gps_day_cache_t day_;
+    Counters counters_;
+
+    char line_[detail::line_capacity];
+    std::size_t line_len_;     // 这一行到目前为止的字节数，可能超过缓冲区
+    char last_;                // 这一行最后一个字节，判断行尾的'\r'
+    bool in_line_;
+
+    int gsa_pointer_;
+    char last_gsv_system_[2];
+    int gsv_pointer_;
+    int gsv_child_pointer_;
+};
+
+} // namespace nmea0183
+
+#endif // NMEA0183_NMEA0183_HPP
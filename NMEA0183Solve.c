@@ -5,12 +5,45 @@
 #include "NMEA0183Solve.h"
 
 // 将度分格式转换为度
+#if GPS_INTEGER_ONLY
+gps_degree_t dm_to_degree(gps_dm_t dm) {
+    // 分钟部分是1e-7分，除以60就是1e-7度，四舍五入
+    return GPS_DM_DEGREES(dm) + (gps_degree_t) ((GPS_DM_MINUTES(dm) + 30) / 60);
+}
+#else
 double dm_to_degree(double dm) {
     int degrees = (int)(dm / 100);
     double minutes = dm - degrees * 100;
     return degrees + minutes / 60.0;
 }
+#endif
+
+// 校验语句的异或校验和（$与*之间所有字符异或）
+// 返回：0=正确，-1=空指针，-3=没有校验和或语句超长，-5=校验和错误
+int nmea_verify_checksum(const char* sentence) {
+    if (sentence == NULL) {
+        return -1;
+    }
+
+    const char* start = sentence;
+    if (*start == '$' || *start == '!') {
+        start++;
+    }
+    const char* p = nmea_find_checksum(start);
+    if (p == NULL || *p != '*' || !isxdigit((unsigned char)p[1]) || !isxdigit((unsigned char)p[2])) {
+        return -3;
+    }
 
+    uint8_t sum = 0;
+    for (const char* c = start; c < p; c++) {
+        sum ^= (uint8_t)*c;
+    }
+    int high = isdigit((unsigned char)p[1]) ? p[1] - '0' : toupper((unsigned char)p[1]) - 'A' + 10;
+    int low = isdigit((unsigned char)p[2]) ? p[2] - '0' : toupper((unsigned char)p[2]) - 'A' + 10;
+    return (high << 4 | low) == sum ? 0 : -5;
+}
+
+#if GPS_ENABLE_RMC
 // 解析GPRMC语句
 int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
     if (sentence == NULL || rmc == NULL) {
@@ -23,13 +56,13 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -42,14 +75,14 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
     memset(rmc, 0, sizeof(gps_rmc_t));
     rmc->utc_time = -1.0;
     rmc->status = -1;
-    rmc->latitude = NAN;
-    rmc->longitude = NAN;
+    rmc->latitude = GPS_NAN;
+    rmc->longitude = GPS_NAN;
     rmc->speed_over_ground = -1.0;
     rmc->course_over_ground = -1.0;
     rmc->day = -1;
     rmc->month = -1;
     rmc->year = -1;
-    rmc->magnetic_variation = NAN;
+    rmc->magnetic_variation = GPS_NAN;
     rmc->is_magnetic_east = -1;
     rmc->mode_indicator = -1;
     rmc->nav_status[0] = '\0';
@@ -138,14 +171,14 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
     // 解析时间 hhmmss.sss
     if (strlen(time_str) >= 6) {
         int hours, minutes;
-        double seconds;
-        if (sscanf(time_str, "%2d%2d%lf", &hours, &minutes, &seconds) >= 2) {
+        gps_second_t seconds;
+        if (GPS_PARSE_HMS(time_str, &hours, &minutes, &seconds) >= 2) {
             if (hours >= 0 && hours <= 23 && minutes >= 0 && minutes <= 59 &&
-                seconds >= 0.0 && seconds < 60.0) {
+                seconds >= 0 && seconds < GPS_CONST(60.0, SECOND)) {
                 rmc->hour = hours;
                 rmc->minute = minutes;
                 rmc->second = seconds;
-                rmc->utc_time = hours + minutes/60.0 + seconds/3600.0;
+                rmc->utc_time = GPS_UTC_TIME(hours, minutes, seconds);
                 rmc->has_time = 1;
             }
         }
@@ -161,10 +194,10 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
 
     // 解析纬度
     if (strlen(lat_str) > 0) {
-        double lat_dm = atof(lat_str);
+        gps_dm_t lat_dm = GPS_PARSE_DM(lat_str);
         if (lat_dm > 0) {
-            rmc->latitude_degrees = (int)(lat_dm / 100);
-            rmc->latitude_minutes = lat_dm - rmc->latitude_degrees * 100;
+            rmc->latitude_degrees = GPS_DM_DEGREES(lat_dm);
+            rmc->latitude_minutes = GPS_DM_MINUTES(lat_dm);
             rmc->latitude = dm_to_degree(lat_dm);
 
             if (strlen(lat_hemi) > 0 && (lat_hemi[0] == 'N' || lat_hemi[0] == 'S')) {
@@ -179,10 +212,10 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
 
     // 解析经度
     if (strlen(lon_str) > 0) {
-        double lon_dm = atof(lon_str);
+        gps_dm_t lon_dm = GPS_PARSE_DM(lon_str);
         if (lon_dm > 0) {
-            rmc->longitude_degrees = (int)(lon_dm / 100);
-            rmc->longitude_minutes = lon_dm - rmc->longitude_degrees * 100;
+            rmc->longitude_degrees = GPS_DM_DEGREES(lon_dm);
+            rmc->longitude_minutes = GPS_DM_MINUTES(lon_dm);
             rmc->longitude = dm_to_degree(lon_dm);
 
             if (strlen(lon_hemi) > 0 && (lon_hemi[0] == 'E' || lon_hemi[0] == 'W')) {
@@ -197,16 +230,16 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
 
     // 解析速度和航向
     if (strlen(speed_str) > 0) {
-        double speed = atof(speed_str);
-        if (speed >= 0.0 && speed <= 999.9) {
+        gps_speed_t speed = GPS_PARSE(speed_str, SPEED);
+        if (speed >= 0 && speed <= GPS_CONST(999.9, SPEED)) {
             rmc->speed_over_ground = speed;
             rmc->has_speed = 1;
         }
     }
 
     if (strlen(course_str) > 0) {
-        double course = atof(course_str);
-        if (course >= 0.0 && course < 360.0) {
+        gps_angle_t course = GPS_PARSE(course_str, ANGLE);
+        if (course >= 0 && course < GPS_CONST(360.0, ANGLE)) {
             rmc->course_over_ground = course;
             rmc->has_course = 1;
         }
@@ -215,14 +248,12 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
     // 解析日期 ddmmyy
     if (strlen(date_str) >= 6) {
         int day, month, year_short;
-        if (sscanf(date_str, "%2d%2d%2d", &day, &month, &year_short) == 3) {
+        if (GPS_PARSE_DMY(date_str, &day, &month, &year_short) == 3) {
             if (day >= 1 && day <= 31 && month >= 1 && month <= 12) {
                 rmc->day = day;
                 rmc->month = month;
-                rmc->year = 2000 + year_short; // 假设是2000年之后的年份
-                if (rmc->year < 2000 || rmc->year > 2100) {
-                    rmc->year = 1900 + year_short; // 回退到1900年代
-                }
+                // 两位年份：GPS从1980年开始，80~99是19xx，其余是20xx（到2079年都正确）
+                rmc->year = year_short >= NMEA_YEAR_PIVOT ? 1900 + year_short : 2000 + year_short;
                 rmc->has_date = 1;
             }
         }
@@ -230,8 +261,8 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
 
     // 解析磁偏角
     if (strlen(mag_var_str) > 0) {
-        double mag_var = atof(mag_var_str);
-        if (mag_var >= 0.0 && mag_var <= 180.0) {
+        gps_angle_t mag_var = GPS_PARSE(mag_var_str, ANGLE);
+        if (mag_var >= 0 && mag_var <= GPS_CONST(180.0, ANGLE)) {
             rmc->magnetic_variation = mag_var;
 
             if (strlen(mag_dir) > 0 && (mag_dir[0] == 'E' || mag_dir[0] == 'W')) {
@@ -268,6 +299,8 @@ int parse_gprmc(const char* sentence, gps_rmc_t* rmc) {
 
     return 0;
 }
+#endif
+#if GPS_ENABLE_RMC && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gprmc_info(const gps_rmc_t* rmc) {
     printf("=== GPS RMC Data ===\n");
@@ -364,6 +397,8 @@ void print_gprmc_info(const gps_rmc_t* rmc) {
 
     printf("====================\n");
 }
+#endif
+#if GPS_ENABLE_GGA
 // 解析GPGGA语句
 int parse_gpgga(const char* sentence, gps_gga_t* gga) {
     if (sentence == NULL || gga == NULL) {
@@ -376,13 +411,13 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -394,13 +429,13 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
     // 初始化结构体
     memset(gga, 0, sizeof(gps_gga_t));
     gga->utc_time = -1.0;
-    gga->latitude = NAN;
-    gga->longitude = NAN;
+    gga->latitude = GPS_NAN;
+    gga->longitude = GPS_NAN;
     gga->fix_quality = -1;
     gga->satellites_used = -1;
     gga->hdop = -1.0;
-    gga->altitude = NAN;
-    gga->geoid_height = NAN;
+    gga->altitude = GPS_NAN;
+    gga->geoid_height = GPS_NAN;
     gga->diff_age = -1.0;
     gga->diff_station_id = -1;
 
@@ -493,14 +528,14 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
     // 解析时间 hhmmss.sss
     if (strlen(time_str) >= 6) {
         int hours, minutes;
-        double seconds;
-        if (sscanf(time_str, "%2d%2d%lf", &hours, &minutes, &seconds) >= 2) {
+        gps_second_t seconds;
+        if (GPS_PARSE_HMS(time_str, &hours, &minutes, &seconds) >= 2) {
             if (hours >= 0 && hours <= 23 && minutes >= 0 && minutes <= 59 &&
-                seconds >= 0.0 && seconds < 60.0) {
+                seconds >= 0 && seconds < GPS_CONST(60.0, SECOND)) {
                 gga->hour = hours;
                 gga->minute = minutes;
                 gga->second = seconds;
-                gga->utc_time = hours + minutes/60.0 + seconds/3600.0;
+                gga->utc_time = GPS_UTC_TIME(hours, minutes, seconds);
                 gga->has_time = 1;
             }
         }
@@ -508,10 +543,10 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析纬度
     if (strlen(lat_str) > 0) {
-        double lat_dm = atof(lat_str);
+        gps_dm_t lat_dm = GPS_PARSE_DM(lat_str);
         if (lat_dm > 0) {
-            gga->latitude_degrees = (int)(lat_dm / 100);
-            gga->latitude_minutes = lat_dm - gga->latitude_degrees * 100;
+            gga->latitude_degrees = GPS_DM_DEGREES(lat_dm);
+            gga->latitude_minutes = GPS_DM_MINUTES(lat_dm);
             gga->latitude = dm_to_degree(lat_dm);
 
             if (strlen(lat_hemi) > 0 && (lat_hemi[0] == 'N' || lat_hemi[0] == 'S')) {
@@ -526,10 +561,10 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析经度
     if (strlen(lon_str) > 0) {
-        double lon_dm = atof(lon_str);
+        gps_dm_t lon_dm = GPS_PARSE_DM(lon_str);
         if (lon_dm > 0) {
-            gga->longitude_degrees = (int)(lon_dm / 100);
-            gga->longitude_minutes = lon_dm - gga->longitude_degrees * 100;
+            gga->longitude_degrees = GPS_DM_DEGREES(lon_dm);
+            gga->longitude_minutes = GPS_DM_MINUTES(lon_dm);
             gga->longitude = dm_to_degree(lon_dm);
 
             if (strlen(lon_hemi) > 0 && (lon_hemi[0] == 'E' || lon_hemi[0] == 'W')) {
@@ -544,7 +579,7 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析定位质量
     if (strlen(fix_quality_str) > 0) {
-        int quality = atoi(fix_quality_str);
+        int quality = GPS_PARSE_INT(fix_quality_str);
         if (quality >= 0 && quality <= 8) {
             gga->fix_quality = quality;
             gga->has_fix_quality = 1;
@@ -553,7 +588,7 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析使用卫星数量
     if (strlen(satellites_str) > 0) {
-        int satellites = atoi(satellites_str);
+        int satellites = GPS_PARSE_INT(satellites_str);
         if (satellites >= 0 && satellites <= 99) {
             gga->satellites_used = satellites;
             gga->has_satellites = 1;
@@ -562,8 +597,8 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析水平精度因子
     if (strlen(hdop_str) > 0) {
-        double hdop = atof(hdop_str);
-        if (hdop >= 0.0 && hdop <= 99.9) {
+        gps_dop_t hdop = GPS_PARSE(hdop_str, DOP);
+        if (hdop >= 0 && hdop <= GPS_CONST(99.9, DOP)) {
             gga->hdop = hdop;
             gga->has_hdop = 1;
         }
@@ -571,8 +606,8 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析天线高度
     if (strlen(altitude_str) > 0) {
-        double altitude = atof(altitude_str);
-        if (altitude >= -9999.9 && altitude <= 9999.9) {
+        gps_meter_t altitude = GPS_PARSE(altitude_str, METER);
+        if (altitude >= GPS_CONST(-9999.9, METER) && altitude <= GPS_CONST(9999.9, METER)) {
             gga->altitude = altitude;
 
             // 验证单位（应该是'M'）
@@ -585,8 +620,8 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析大地水准面高度
     if (strlen(geoid_height_str) > 0) {
-        double geoid_height = atof(geoid_height_str);
-        if (geoid_height >= -9999.9 && geoid_height <= 9999.9) {
+        gps_meter_t geoid_height = GPS_PARSE(geoid_height_str, METER);
+        if (geoid_height >= GPS_CONST(-9999.9, METER) && geoid_height <= GPS_CONST(9999.9, METER)) {
             gga->geoid_height = geoid_height;
 
             // 验证单位（应该是'M'）
@@ -599,8 +634,8 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析差分数据期限
     if (strlen(diff_age_str) > 0) {
-        double diff_age = atof(diff_age_str);
-        if (diff_age >= 0.0) {
+        gps_second_t diff_age = GPS_PARSE(diff_age_str, SECOND);
+        if (diff_age >= 0) {
             gga->diff_age = diff_age;
             gga->has_diff_age = 1;
         }
@@ -608,7 +643,7 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     // 解析差分基站标号
     if (strlen(diff_station_str) > 0) {
-        int station_id = atoi(diff_station_str);
+        int station_id = GPS_PARSE_INT(diff_station_str);
         if (station_id >= 0 && station_id <= 4095) { // 扩展范围
             gga->diff_station_id = station_id;
             gga->has_diff_station = 1;
@@ -617,6 +652,8 @@ int parse_gpgga(const char* sentence, gps_gga_t* gga) {
 
     return 0;
 }
+#endif
+#if GPS_ENABLE_GGA && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gpgga_info(const gps_gga_t* gga) {
     printf("=== GPS GGA Data ===\n");
@@ -706,7 +743,9 @@ void print_gpgga_info(const gps_gga_t* gga) {
 
     printf("====================\n");
 }
+#endif
 
+#if GPS_ENABLE_VTG
 // 解析GPVTG语句
 int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
     if (sentence == NULL || vtg == NULL) {
@@ -719,13 +758,13 @@ int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -805,7 +844,7 @@ int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
 
     // 解析真北航向
     if (strlen(course_true_str) > 0) {
-        vtg->course_true = atof(course_true_str);
+        vtg->course_true = GPS_PARSE(course_true_str, ANGLE);
         vtg->has_true_course = 1;
 
         // 验证指示符
@@ -816,7 +855,7 @@ int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
 
     // 解析磁北航向
     if (strlen(course_magnetic_str) > 0) {
-        vtg->course_magnetic = atof(course_magnetic_str);
+        vtg->course_magnetic = GPS_PARSE(course_magnetic_str, ANGLE);
         vtg->has_magnetic_course = 1;
 
         // 验证指示符
@@ -827,7 +866,7 @@ int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
 
     // 解析节速度
     if (strlen(speed_knots_str) > 0) {
-        vtg->speed_knots = atof(speed_knots_str);
+        vtg->speed_knots = GPS_PARSE(speed_knots_str, SPEED);
         vtg->has_speed_knots = 1;
 
         // 验证指示符
@@ -838,7 +877,7 @@ int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
 
     // 解析公里/小时速度
     if (strlen(speed_kmh_str) > 0) {
-        vtg->speed_kmh = atof(speed_kmh_str);
+        vtg->speed_kmh = GPS_PARSE(speed_kmh_str, SPEED);
         vtg->has_speed_kmh = 1;
 
         // 验证指示符
@@ -861,7 +900,9 @@ int parse_gpvtg(const char* sentence, gps_vtg_t* vtg) {
 
     return 0;
 }
+#endif
 
+#if GPS_ENABLE_VTG && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gpvtg_info(const gps_vtg_t* vtg) {
     printf("=== GPS VTG Data ===\n");
@@ -897,8 +938,10 @@ void print_gpvtg_info(const gps_vtg_t* vtg) {
 
     printf("====================\n");
 }
+#endif
 
 
+#if GPS_ENABLE_GLL
 // 解析GPGLL语句
 int parse_gpgll(const char* sentence, gps_gll_t* gll) {
     if (sentence == NULL || gll == NULL) {
@@ -911,13 +954,13 @@ int parse_gpgll(const char* sentence, gps_gll_t* gll) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -928,8 +971,8 @@ int parse_gpgll(const char* sentence, gps_gll_t* gll) {
 
     // 初始化结构体
     memset(gll, 0, sizeof(gps_gll_t));
-    gll->latitude = NAN;
-    gll->longitude = NAN;
+    gll->latitude = GPS_NAN;
+    gll->longitude = GPS_NAN;
     gll->utc_time = -1.0;
     gll->data_valid = -1;
     gll->mode_indicator = -1;
@@ -987,10 +1030,10 @@ int parse_gpgll(const char* sentence, gps_gll_t* gll) {
 
     // 解析纬度
     if (strlen(lat_str) > 0) {
-        double lat_dm = atof(lat_str);
+        gps_dm_t lat_dm = GPS_PARSE_DM(lat_str);
         if (lat_dm > 0) {
-            gll->latitude_degrees = (int)(lat_dm / 100);
-            gll->latitude_minutes = lat_dm - gll->latitude_degrees * 100;
+            gll->latitude_degrees = GPS_DM_DEGREES(lat_dm);
+            gll->latitude_minutes = GPS_DM_MINUTES(lat_dm);
             gll->latitude = dm_to_degree(lat_dm);
 
             if (strlen(lat_hemi) > 0) {
@@ -1005,10 +1048,10 @@ int parse_gpgll(const char* sentence, gps_gll_t* gll) {
 
     // 解析经度
     if (strlen(lon_str) > 0) {
-        double lon_dm = atof(lon_str);
+        gps_dm_t lon_dm = GPS_PARSE_DM(lon_str);
         if (lon_dm > 0) {
-            gll->longitude_degrees = (int)(lon_dm / 100);
-            gll->longitude_minutes = lon_dm - gll->longitude_degrees * 100;
+            gll->longitude_degrees = GPS_DM_DEGREES(lon_dm);
+            gll->longitude_minutes = GPS_DM_MINUTES(lon_dm);
             gll->longitude = dm_to_degree(lon_dm);
 
             if (strlen(lon_hemi) > 0) {
@@ -1024,12 +1067,12 @@ int parse_gpgll(const char* sentence, gps_gll_t* gll) {
     // 解析时间 hhmmss.sss
     if (strlen(time_str) >= 6) {
         int hours, minutes;
-        double seconds;
-        if (sscanf(time_str, "%2d%2d%lf", &hours, &minutes, &seconds) >= 2) {
+        gps_second_t seconds;
+        if (GPS_PARSE_HMS(time_str, &hours, &minutes, &seconds) >= 2) {
             gll->hour = hours;
             gll->minute = minutes;
             gll->second = seconds;
-            gll->utc_time = hours + minutes/60.0 + seconds/3600.0;
+            gll->utc_time = GPS_UTC_TIME(hours, minutes, seconds);
             gll->has_time = 1;
         }
     }
@@ -1056,7 +1099,9 @@ int parse_gpgll(const char* sentence, gps_gll_t* gll) {
 
     return 0;
 }
+#endif
 
+#if GPS_ENABLE_GLL && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gpgll_info(const gps_gll_t* gll) {
     printf("=== GPS GLL Data ===\n");
@@ -1109,8 +1154,43 @@ void print_gpgll_info(const gps_gll_t* gll) {
     printf("\n");
     printf("====================\n");
 }
+#endif
 
+#if GPS_ENABLE_DISTANCE
 // 计算两个GLL位置之间的距离（ Haversine公式）
+#if GPS_INTEGER_ONLY
+// 整数模式：等距圆柱投影近似，cos查表，返回厘米
+// 纬度60度以内、两点相距几百公里以内时和Haversine相差约0.01%，高纬度和远距离误差会变大
+gps_distance_t calculate_distance(const gps_gll_t* gll1, const gps_gll_t* gll2) {
+    if (!gll1->has_latitude || !gll1->has_longitude ||
+        !gll2->has_latitude || !gll2->has_longitude) {
+        return -1;
+    }
+
+    int64_t dlat = (int64_t) gll2->latitude - gll1->latitude;
+    int64_t dlon = (int64_t) gll2->longitude - gll1->longitude;
+    if (dlon > 180LL * GPS_DEGREE_SCALE) {
+        dlon -= 360LL * GPS_DEGREE_SCALE;
+    } else if (dlon < -180LL * GPS_DEGREE_SCALE) {
+        dlon += 360LL * GPS_DEGREE_SCALE;
+    }
+    gps_degree_t mean_lat = (gps_degree_t) (((int64_t) gll1->latitude + gll2->latitude) / 2);
+
+    // 地球半径6371km，1e-7度对应 1.1119493 厘米
+    int64_t north = dlat * 11119493 / 10000000;
+    int64_t east = (dlon * gps_cos_q15(mean_lat) >> 15) * 11119493 / 10000000;
+    uint64_t x = (uint64_t) (east < 0 ? -east : east);
+    uint64_t y = (uint64_t) (north < 0 ? -north : north);
+    int shift = 0;
+    while ((x | y) >= (1ULL << 31)) {
+        x >>= 1;
+        y >>= 1;
+        shift++;
+    }
+    uint64_t distance = (uint64_t) gps_isqrt64(x * x + y * y) << shift;
+    return distance > INT32_MAX ? INT32_MAX : (gps_distance_t) distance;
+}
+#else
 double calculate_distance(const gps_gll_t* gll1, const gps_gll_t* gll2) {
     if (!gll1->has_latitude || !gll1->has_longitude ||
         !gll2->has_latitude || !gll2->has_longitude) {
@@ -1131,7 +1211,10 @@ double calculate_distance(const gps_gll_t* gll1, const gps_gll_t* gll2) {
 
     return 6371000.0 * c; // 地球半径6371km，返回米
 }
+#endif
+#endif
 
+#if GPS_ENABLE_ZDA
 // 解析GPZDA语句
 int parse_gpzda(const char* sentence, gps_zda_t* zda) {
     if (sentence == NULL || zda == NULL) {
@@ -1144,13 +1227,13 @@ int parse_gpzda(const char* sentence, gps_zda_t* zda) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -1217,14 +1300,14 @@ int parse_gpzda(const char* sentence, gps_zda_t* zda) {
     // 解析时间 hhmmss.sss
     if (strlen(time_str) >= 6) {
         int hours, minutes;
-        double seconds;
-        if (sscanf(time_str, "%2d%2d%lf", &hours, &minutes, &seconds) >= 2) {
+        gps_second_t seconds;
+        if (GPS_PARSE_HMS(time_str, &hours, &minutes, &seconds) >= 2) {
             if (hours >= 0 && hours <= 23 && minutes >= 0 && minutes <= 59 &&
-                seconds >= 0.0 && seconds < 60.0) {
+                seconds >= 0 && seconds < GPS_CONST(60.0, SECOND)) {
                 zda->hour = hours;
                 zda->minute = minutes;
                 zda->second = seconds;
-                zda->utc_time = hours + minutes/60.0 + seconds/3600.0;
+                zda->utc_time = GPS_UTC_TIME(hours, minutes, seconds);
                 zda->has_time = 1;
             }
         }
@@ -1232,13 +1315,13 @@ int parse_gpzda(const char* sentence, gps_zda_t* zda) {
 
     // 解析日期
     if (strlen(day_str) > 0) {
-        zda->day = atoi(day_str);
+        zda->day = GPS_PARSE_INT(day_str);
     }
     if (strlen(month_str) > 0) {
-        zda->month = atoi(month_str);
+        zda->month = GPS_PARSE_INT(month_str);
     }
     if (strlen(year_str) > 0) {
-        zda->year = atoi(year_str);
+        zda->year = GPS_PARSE_INT(year_str);
         // 处理2位数年份（假设是2000年之后的年份）
         if (zda->year < 100) {
             zda->year += 2000;
@@ -1252,10 +1335,10 @@ int parse_gpzda(const char* sentence, gps_zda_t* zda) {
 
     // 解析时区信息
     if (strlen(tz_hours_str) > 0) {
-        zda->local_timezone_hours = atoi(tz_hours_str);
+        zda->local_timezone_hours = GPS_PARSE_INT(tz_hours_str);
     }
     if (strlen(tz_minutes_str) > 0) {
-        zda->local_timezone_minutes = atoi(tz_minutes_str);
+        zda->local_timezone_minutes = GPS_PARSE_INT(tz_minutes_str);
     }
     if (strlen(tz_hours_str) > 0 || strlen(tz_minutes_str) > 0) {
         zda->has_timezone = 1;
@@ -1263,7 +1346,9 @@ int parse_gpzda(const char* sentence, gps_zda_t* zda) {
 
     return 0;
 }
+#endif
 
+#if GPS_ENABLE_ZDA && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gpzda_info(const gps_zda_t* zda) {
     printf("=== GPS ZDA Data ===\n");
@@ -1301,4 +1386,5 @@ void print_gpzda_info(const gps_zda_t* zda) {
     printf("\n");
 
     printf("====================\n");
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
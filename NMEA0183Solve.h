@@ -6,32 +6,34 @@
 #define NMEA0183_NMEA0183_H
 #include "SatelliteSolve.h"
 
+// 下面的数值字段在整数模式（GPS_INTEGER_ONLY）下是定标整数，单位见FixedPoint.h
+
 // GPS RMC 数据结构体
 typedef struct {
     // 时间信息
-    double utc_time;           // UTC时间（小时+分钟/60+秒/3600）
+    gps_tod_t utc_time;        // UTC时间（小时+分钟/60+秒/3600）
     int hour;                  // 小时 (00-23)
     int minute;                // 分钟 (00-59)
-    double second;             // 秒（含小数部分，00.000-59.999）
+    gps_second_t second;       // 秒（含小数部分，00.000-59.999）
 
     // 定位状态
     int status;                // 定位状态：1=有效定位，0=无效定位，-1=未知
 
     // 纬度信息
-    double latitude;           // 纬度（度，北纬为正，南纬为负）
-    double latitude_degrees;   // 纬度度数部分
-    double latitude_minutes;   // 纬度分钟部分
+    gps_degree_t latitude;     // 纬度（度，北纬为正，南纬为负）
+    gps_degree_t latitude_degrees; // 纬度度数部分
+    gps_minute_t latitude_minutes; // 纬度分钟部分
     int is_north;              // 是否北半球：1=北半球，0=南半球，-1=未知
 
     // 经度信息
-    double longitude;          // 经度（度，东经为正，西经为负）
-    double longitude_degrees;  // 经度度数部分
-    double longitude_minutes;  // 经度分钟部分
+    gps_degree_t longitude;    // 经度（度，东经为正，西经为负）
+    gps_degree_t longitude_degrees; // 经度度数部分
+    gps_minute_t longitude_minutes; // 经度分钟部分
     int is_east;               // 是否东经：1=东经，0=西经，-1=未知
 
     // 运动信息
-    double speed_over_ground;  // 地面速率（节，000.0~999.9）
-    double course_over_ground; // 地面航向（度，000.0~359.9）
+    gps_speed_t speed_over_ground; // 地面速率（节，000.0~999.9）
+    gps_angle_t course_over_ground; // 地面航向（度，000.0~359.9）
 
     // 日期信息
     int day;                   // 日 (01-31)
@@ -39,7 +41,7 @@ typedef struct {
     int year;                  // 年（完整年份，如2023）
 
     // 磁偏角信息
-    double magnetic_variation; // 磁偏角（度，000.0~180.0）
+    gps_angle_t magnetic_variation; // 磁偏角（度，000.0~180.0）
     int is_magnetic_east;      // 磁偏角方向：1=东，0=西，-1=未知
 
     // 模式指示
@@ -63,33 +65,33 @@ typedef struct {
 // GPS GGA 数据结构体
 typedef struct {
     // 时间信息
-    double utc_time;           // UTC时间（小时+分钟/60+秒/3600）
+    gps_tod_t utc_time;        // UTC时间（小时+分钟/60+秒/3600）
     int hour;                  // 小时 (00-23)
     int minute;                // 分钟 (00-59)
-    double second;             // 秒（含小数部分，00.000-59.999）
+    gps_second_t second;       // 秒（含小数部分，00.000-59.999）
 
     // 位置信息
-    double latitude;           // 纬度（度，北纬为正，南纬为负）
-    double latitude_degrees;   // 纬度度数部分
-    double latitude_minutes;   // 纬度分钟部分
+    gps_degree_t latitude;     // 纬度（度，北纬为正，南纬为负）
+    gps_degree_t latitude_degrees; // 纬度度数部分
+    gps_minute_t latitude_minutes; // 纬度分钟部分
     int is_north;              // 是否北半球：1=北半球，0=南半球，-1=未知
 
-    double longitude;          // 经度（度，东经为正，西经为负）
-    double longitude_degrees;  // 经度度数部分
-    double longitude_minutes;  // 经度分钟部分
+    gps_degree_t longitude;    // 经度（度，东经为正，西经为负）
+    gps_degree_t longitude_degrees; // 经度度数部分
+    gps_minute_t longitude_minutes; // 经度分钟部分
     int is_east;               // 是否东经：1=东经，0=西经，-1=未知
 
     // 定位质量信息
     int fix_quality;           // 定位质量：0=无效，1=GPS定位，2=差分GPS定位，3=PPS定位，4=RTK，5=浮点RTK，6=估算，7=手动，8=模拟
     int satellites_used;       // 使用卫星数量（00-12）
-    double hdop;               // 水平精度因子（0.5-99.9）
+    gps_dop_t hdop;            // 水平精度因子（0.5-99.9）
 
     // 高程信息
-    double altitude;           // 天线离海平面的高度（米，-9999.9到9999.9）
-    double geoid_height;       // 大地水准面高度（米，-9999.9到9999.9）
+    gps_meter_t altitude;      // 天线离海平面的高度（米，-9999.9到9999.9）
+    gps_meter_t geoid_height;  // 大地水准面高度（米，-9999.9到9999.9）
 
     // 差分信息
-    double diff_age;           // 差分GPS数据期限（秒）
+    gps_second_t diff_age;     // 差分GPS数据期限（秒）
     int diff_station_id;       // 差分参考基站标号（0000-1023）
 
     // 数据有效性标志
@@ -108,12 +110,12 @@ typedef struct {
 // GPS VTG 数据结构体
 typedef struct {
     // 航向信息
-    double course_true;        // 以正北为参考基准的地面航向（000~359度）
-    double course_magnetic;    // 以磁北为参考基准的地面航向（000~359度）
+    gps_angle_t course_true;   // 以正北为参考基准的地面航向（000~359度）
+    gps_angle_t course_magnetic; // 以磁北为参考基准的地面航向（000~359度）
 
     // 地面速率信息
-    double speed_knots;        // 地面速率（节，000.0~999.9）
-    double speed_kmh;          // 地面速率（公里/小时，0000.0~1851.8）
+    gps_speed_t speed_knots;   // 地面速率（节，000.0~999.9）
+    gps_speed_t speed_kmh;     // 地面速率（公里/小时，0000.0~1851.8）
 
     // 模式指示
     int mode;                  // 模式：0=自主定位，1=差分，2=估算，3=数据无效，-1=未知/未提供
@@ -129,21 +131,21 @@ typedef struct {
 // GPS GLL 数据结构体
 typedef struct {
     // 位置信息
-    double latitude;           // 纬度（度，北纬为正，南纬为负）
-    double latitude_degrees;   // 纬度度数部分
-    double latitude_minutes;   // 纬度分钟部分
+    gps_degree_t latitude;     // 纬度（度，北纬为正，南纬为负）
+    gps_degree_t latitude_degrees; // 纬度度数部分
+    gps_minute_t latitude_minutes; // 纬度分钟部分
     int is_north;              // 是否北半球：1=北半球，0=南半球
 
-    double longitude;          // 经度（度，东经为正，西经为负）
-    double longitude_degrees;  // 经度度数部分
-    double longitude_minutes;  // 经度分钟部分
+    gps_degree_t longitude;    // 经度（度，东经为正，西经为负）
+    gps_degree_t longitude_degrees; // 经度度数部分
+    gps_minute_t longitude_minutes; // 经度分钟部分
     int is_east;               // 是否东经：1=东经，0=西经
 
     // 时间信息
-    double utc_time;           // UTC时间（小时+分钟/60+秒/3600）
+    gps_tod_t utc_time;        // UTC时间（小时+分钟/60+秒/3600）
     int hour;                  // 小时
     int minute;                // 分钟
-    double second;             // 秒（含小数部分）
+    gps_second_t second;       // 秒（含小数部分）
 
     // 数据状态
     int data_valid;            // 数据有效性：1=有效，0=无效
@@ -161,10 +163,10 @@ typedef struct {
 // GPS ZDA 数据结构体
 typedef struct {
     // 时间信息
-    double utc_time;           // UTC时间（小时+分钟/60+秒/3600）
+    gps_tod_t utc_time;        // UTC时间（小时+分钟/60+秒/3600）
     int hour;                  // 小时 (00-23)
     int minute;                // 分钟 (00-59)
-    double second;             // 秒（含小数部分，00.000-59.999）
+    gps_second_t second;       // 秒（含小数部分，00.000-59.999）
 
     // 日期信息
     int day;                   // 日 (01-31)
@@ -182,29 +184,124 @@ typedef struct {
 
 } gps_zda_t;
 
+// 成员随GPSConfig.h里打开的语句类型增减
 typedef struct {
+#if GPS_ENABLE_GGA
     gps_gga_t gga;
+#endif
+#if GPS_ENABLE_GLL
     gps_gll_t gll;
+#endif
+#if GPS_ENABLE_SATELLITES
     gps_satellites satellites;
+#endif
+#if GPS_ENABLE_RMC
     gps_rmc_t rmc;
+#endif
+#if GPS_ENABLE_VTG
     gps_vtg_t vtg;
+#endif
+#if GPS_ENABLE_ZDA
     gps_zda_t zda;
+#endif
+    int64_t utc_ns;            // 历元的UTC时间（Unix纪元纳秒），solve_once发布前由gps_epoch_time_update算一次
+    int has_utc_ns;
 }gps_data_t;
+
+// 全零的聚合初始化；C++里const对象必须显式初始化，但{0}会触发-Wmissing-field-initializers
+#ifdef __cplusplus
+#define GPS_ZERO_INIT {}
+#else
+#define GPS_ZERO_INIT {0}
+#endif
+
+// 按语句类型取历元中的结果；该类型没编译进来时返回一个全零的常量（所有has_xxx都为0），
+// 这样融合、轨迹等上层模块不用为每种裁剪组合写条件编译
+static inline const gps_gga_t* gps_data_gga(const gps_data_t* data) {
+#if GPS_ENABLE_GGA
+    return &data->gga;
+#else
+    static const gps_gga_t none = GPS_ZERO_INIT;
+    (void)data;
+    return &none;
+#endif
+}
+static inline const gps_gll_t* gps_data_gll(const gps_data_t* data) {
+#if GPS_ENABLE_GLL
+    return &data->gll;
+#else
+    static const gps_gll_t none = GPS_ZERO_INIT;
+    (void)data;
+    return &none;
+#endif
+}
+static inline const gps_rmc_t* gps_data_rmc(const gps_data_t* data) {
+#if GPS_ENABLE_RMC
+    return &data->rmc;
+#else
+    static const gps_rmc_t none = GPS_ZERO_INIT;
+    (void)data;
+    return &none;
+#endif
+}
+static inline const gps_vtg_t* gps_data_vtg(const gps_data_t* data) {
+#if GPS_ENABLE_VTG
+    return &data->vtg;
+#else
+    static const gps_vtg_t none = GPS_ZERO_INIT;
+    (void)data;
+    return &none;
+#endif
+}
+static inline const gps_zda_t* gps_data_zda(const gps_data_t* data) {
+#if GPS_ENABLE_ZDA
+    return &data->zda;
+#else
+    static const gps_zda_t none = GPS_ZERO_INIT;
+    (void)data;
+    return &none;
+#endif
+}
+
+int nmea_verify_checksum(const char* sentence);
+
+#if GPS_ENABLE_RMC
 int parse_gprmc(const char* sentence, gps_rmc_t* rmc);
+#if GPS_ENABLE_PRINT
 void print_gprmc_info(const gps_rmc_t* rmc);
+#endif
+#endif
 
+#if GPS_ENABLE_GGA
 int parse_gpgga(const char* sentence, gps_gga_t* gga);
+#if GPS_ENABLE_PRINT
 void print_gpgga_info(const gps_gga_t* gga);
+#endif
+#endif
 
+#if GPS_ENABLE_VTG
 int parse_gpvtg(const char* sentence, gps_vtg_t* vtg);
+#if GPS_ENABLE_PRINT
 void print_gpvtg_info(const gps_vtg_t* vtg);
+#endif
+#endif
 
+#if GPS_ENABLE_GLL
 int parse_gpgll(const char* sentence, gps_gll_t* gll);
+#if GPS_ENABLE_PRINT
 void print_gpgll_info(const gps_gll_t* gll);
-double calculate_distance(const gps_gll_t* gll1, const gps_gll_t* gll2);
+#endif
+#endif
+#if GPS_ENABLE_DISTANCE
+gps_distance_t calculate_distance(const gps_gll_t* gll1, const gps_gll_t* gll2);
+#endif
 
+#if GPS_ENABLE_ZDA
 int parse_gpzda(const char* sentence, gps_zda_t* zda);
+#if GPS_ENABLE_PRINT
 void print_gpzda_info(const gps_zda_t* zda);
+#endif
+#endif
 
 
 #endif // NMEA0183_NMEA0183_H
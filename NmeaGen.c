@@ -0,0 +1,610 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "NmeaGen.h"
+#include "GnssTime.h"
+
+#include <math.h>
+#include <string.h>
+
+#define GEN_EARTH_RADIUS 6371008.8
+#define GEN_PI 3.14159265358979323846
+#define GEN_DEG (GEN_PI / 180.0)
+#define GEN_MS_TO_KNOTS 1.9438444924
+#define GEN_MS_TO_KMH 3.6
+#define GEN_MASK_MIN_ELEVATION 10  // 低于这个仰角的卫星不参与定位
+#define GEN_TRUNCATE_MIN 7         // 截断后至少保留"$xxYYY,"，和GPSSolve.c丢弃短行的长度一致
+
+static const char gen_digits[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+static const char gen_hex[] = "0123456789ABCDEF";
+
+// 各系统GSV的发送者、GSA的系统标识（NMEA 4.10）和PRN范围
+static const char gen_gsv_talkers[GPS_GEN_MAX_SYSTEMS][3] = {"GP", "GL", "GA", "GB"};
+static const char gen_system_ids[GPS_GEN_MAX_SYSTEMS] = {'1', '2', '3', '4'};
+static const int gen_prn_first[GPS_GEN_MAX_SYSTEMS] = {1, 65, 1, 1};
+static const int gen_prn_count[GPS_GEN_MAX_SYSTEMS] = {32, 32, 36, 63};
+
+// xorshift64*
+static uint64_t gen_next(gps_gen_t* gen) {
+    uint64_t x = gen->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    gen->rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// [-1,1)均匀分布
+static double gen_uniform(gps_gen_t* gen) {
+    return (double) (gen_next(gen) >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+static char* gen_u2(char* p, uint32_t value) {
+    memcpy(p, gen_digits + value * 2, 2);
+    return p + 2;
+}
+
+// 补零到width位
+static char* gen_pad(char* p, uint32_t value, int width) {
+    for (int i = width - 1; i >= 0; i--) {
+        p[i] = (char) ('0' + value % 10);
+        value /= 10;
+    }
+    return p + width;
+}
+
+static char* gen_uint(char* p, uint32_t value) {
+    char tmp[10];
+    int n = 0;
+    do {
+        tmp[n++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        *p++ = tmp[--n];
+    }
+    return p;
+}
+
+// value×10^-decimals，如 (212,2)->"2.12"
+static char* gen_fixed(char* p, int64_t value, int decimals) {
+    static const uint32_t scale[] = {1, 10, 100, 1000};
+    if (value < 0) {
+        *p++ = '-';
+        value = -value;
+    }
+    p = gen_uint(p, (uint32_t) (value / scale[decimals]));
+    *p++ = '.';
+    return gen_pad(p, (uint32_t) (value % scale[decimals]), decimals);
+}
+
+// 度->NMEA的 (d)ddmm.mmmmm
+static char* gen_angle(char* p, double degrees, int degree_width) {
+    int64_t value = llround(fabs(degrees) * 6000000.0); // 1e-5分
+    p = gen_pad(p, (uint32_t) (value / 6000000), degree_width);
+    value %= 6000000;
+    p = gen_u2(p, (uint32_t) (value / 100000));
+    *p++ = '.';
+    return gen_pad(p, (uint32_t) (value % 100000), 5);
+}
+
+// 8字节一组异或再折叠
+static uint8_t gen_checksum(const char* begin, const char* end) {
+    uint64_t word = 0;
+    while (end - begin >= 8) {
+        uint64_t chunk;
+        memcpy(&chunk, begin, 8);
+        word ^= chunk;
+        begin += 8;
+    }
+    word ^= word >> 32;
+    word ^= word >> 16;
+    word ^= word >> 8;
+    uint8_t sum = (uint8_t) word;
+    while (begin < end) {
+        sum ^= (uint8_t) *begin++;
+    }
+    return sum;
+}
+
+static char* gen_begin(char* p, const char* talker, const char* type) {
+    p[0] = '$';
+    memcpy(p + 1, talker, 2);
+    memcpy(p + 3, type, 3);
+    p[6] = ',';
+    return p + 7;
+}
+
+// 补上校验和和行尾
+static char* gen_finish(char* start, char* p) {
+    uint8_t sum = gen_checksum(start + 1, p);
+    p[0] = '*';
+    p[1] = gen_hex[sum >> 4];
+    p[2] = gen_hex[sum & 0x0F];
+    p[3] = '\r';
+    p[4] = '\n';
+    return p + 5;
+}
+
+// 一个乱码字节：避开NMEA起始符、行尾和UBX/RTCM3的同步字，保证乱码只会被分帧当作跳过的字节，
+// 不会拼出一行假语句或者让分帧等一个假的二进制帧而吞掉后面的语句
+static char gen_garbage_byte(gps_gen_t* gen) {
+    uint8_t c = (uint8_t) gen_next(gen);
+    switch (c) {
+        case '$':
+        case '!':
+        case '\r':
+        case '\n':
+        case 0xB5:
+        case 0xD3:
+            return '#';
+        default:
+            return (char) c;
+    }
+}
+
+// 对刚写好的一条语句[start,end)按比例注入错误，返回新的结尾
+static char* gen_emit(gps_gen_t* gen, char* start, char* end) {
+    const gps_gen_config_t* config = &gen->config;
+    gen->stats.sentences++;
+    if (config->bad_checksum_ppm == 0 && config->truncate_ppm == 0 && config->garbage_ppm == 0) {
+        return end;
+    }
+    uint32_t roll = (uint32_t) (gen_next(gen) % 1000000);
+    if (roll < config->bad_checksum_ppm) {
+        end[-3] = end[-3] == '0' ? '1' : '0';
+        gen->stats.bad_checksums++;
+    } else if ((roll -= config->bad_checksum_ppm) < config->truncate_ppm) {
+        // 截在'*'之前，保留至少"$xxYYY,"这7个字节：再短的行解析端按噪声直接丢掉，不计入截断
+        int body = (int) (end - start) - 5;
+        end = start + GEN_TRUNCATE_MIN + (int) (gen_next(gen) % (uint64_t) (body - GEN_TRUNCATE_MIN));
+        end[0] = '\r';
+        end[1] = '\n';
+        end += 2;
+        gen->stats.truncated++;
+    } else if (roll - config->truncate_ppm < config->garbage_ppm) {
+        int count = 1 + (int) (gen_next(gen) % GPS_GEN_GARBAGE_MAX);
+        for (int i = 0; i < count; i++) {
+            *end++ = gen_garbage_byte(gen);
+        }
+        gen->stats.garbage++;
+        gen->stats.garbage_bytes += (uint64_t) count;
+    }
+    return end;
+}
+
+// Howard Hinnant的civil_from_days
+static void gen_civil_from_days(int64_t days, int* year, int* month, int* day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    *day = (int) (doy - (153 * mp + 2) / 5 + 1);
+    *month = (int) (mp < 10 ? mp + 3 : mp - 9);
+    *year = (int) (yoe + era * 400 + (*month <= 2));
+}
+
+static void gen_update_date(gps_gen_t* gen, int64_t day_index) {
+    int year, month, day;
+    gen_civil_from_days(day_index, &year, &month, &day);
+    char* p = gen_u2(gen->zda_date, (uint32_t) day);
+    *p++ = ',';
+    p = gen_u2(p, (uint32_t) month);
+    *p++ = ',';
+    p = gen_pad(p, (uint32_t) year, 4);
+    *p = '\0';
+    p = gen_u2(gen->rmc_date, (uint32_t) day);
+    p = gen_u2(p, (uint32_t) month);
+    p = gen_u2(p, (uint32_t) (year % 100));
+    *p = '\0';
+    gen->day_index = day_index;
+}
+
+// 卫星移动一步，重新算信噪比、参与定位的卫星数和精度因子
+static void gen_move_satellites(gps_gen_t* gen) {
+    gen->used_count = 0;
+    for (int system = 0; system < GPS_GEN_MAX_SYSTEMS; system++) {
+        for (int i = 0; i < gen->config.satellites[system]; i++) {
+            gps_gen_satellite_t* sat = &gen->satellites[system][i];
+            sat->elevation += sat->elevation_rate;
+            if (sat->elevation > 89.0 || sat->elevation < 1.0) {
+                sat->elevation_rate = -sat->elevation_rate;
+                sat->elevation += 2 * sat->elevation_rate;
+            }
+            sat->azimuth += sat->azimuth_rate;
+            if (sat->azimuth >= 360.0) {
+                sat->azimuth -= 360.0;
+            } else if (sat->azimuth < 0.0) {
+                sat->azimuth += 360.0;
+            }
+            // 仰角越高信号越好，低仰角的偶尔没有信号
+            int snr = 18 + (int) (sat->elevation / 3.0) + (int) (gen_next(gen) % 5);
+            sat->snr = sat->elevation < 5.0 && (gen_next(gen) & 1) ? 0 : snr;
+            if (sat->elevation >= GEN_MASK_MIN_ELEVATION && sat->snr > 0) {
+                gen->used_count++;
+            }
+        }
+    }
+    int used = gen->used_count > 0 ? gen->used_count : 1;
+    gen->hdop10 = 5 + 60 / used;
+    gen->pdop10 = gen->hdop10 * 17 / 10;
+    gen->vdop10 = gen->hdop10 * 14 / 10;
+}
+
+// 重新生成GSA/GSV文本
+static void gen_build_satellite_text(gps_gen_t* gen) {
+    const gps_gen_config_t* config = &gen->config;
+    char* base = gen->sat_text;
+    char* p = base;
+    int n = 0;
+    gen->sat_offsets[0] = 0;
+    for (int system = 0; system < GPS_GEN_MAX_SYSTEMS; system++) {
+        int count = config->satellites[system];
+        if (count == 0) {
+            continue;
+        }
+        gps_gen_satellite_t* sats = gen->satellites[system];
+        if (config->sentence_mask & GPS_GEN_MASK(GPS_SENTENCE_GSA)) {
+            char* start = p;
+            p = gen_begin(p, config->talker, "GSA");
+            *p++ = 'A';
+            *p++ = ',';
+            *p++ = gen->used_count >= 4 ? '3' : '1';
+            int listed = 0;
+            for (int i = 0; i < count && listed < GPS_GEN_GSA_MAX; i++) {
+                if (sats[i].elevation >= GEN_MASK_MIN_ELEVATION && sats[i].snr > 0) {
+                    *p++ = ',';
+                    p = sats[i].prn < 100 ? gen_u2(p, (uint32_t) sats[i].prn) : gen_uint(p, (uint32_t) sats[i].prn);
+                    listed++;
+                }
+            }
+            for (; listed < GPS_GEN_GSA_MAX; listed++) {
+                *p++ = ',';
+            }
+            *p++ = ',';
+            p = gen_fixed(p, gen->pdop10, 1);
+            *p++ = ',';
+            p = gen_fixed(p, gen->hdop10, 1);
+            *p++ = ',';
+            p = gen_fixed(p, gen->vdop10, 1);
+            *p++ = ',';
+            *p++ = gen_system_ids[system];
+            p = gen_finish(start, p);
+            gen->sat_offsets[++n] = (uint16_t) (p - base);
+        }
+        if (config->sentence_mask & GPS_GEN_MASK(GPS_SENTENCE_GSV)) {
+            int messages = (count + 3) / 4;
+            for (int message = 0; message < messages; message++) {
+                char* start = p;
+                p = gen_begin(p, gen_gsv_talkers[system], "GSV");
+                *p++ = (char) ('0' + messages);
+                *p++ = ',';
+                *p++ = (char) ('1' + message);
+                *p++ = ',';
+                p = gen_u2(p, (uint32_t) count);
+                for (int i = message * 4; i < count && i < message * 4 + 4; i++) {
+                    *p++ = ',';
+                    p = sats[i].prn < 100 ? gen_u2(p, (uint32_t) sats[i].prn) : gen_uint(p, (uint32_t) sats[i].prn);
+                    *p++ = ',';
+                    p = gen_u2(p, (uint32_t) sats[i].elevation);
+                    *p++ = ',';
+                    p = gen_pad(p, (uint32_t) sats[i].azimuth, 3);
+                    *p++ = ',';
+                    if (sats[i].snr > 0) {
+                        p = gen_u2(p, (uint32_t) sats[i].snr);
+                    }
+                }
+                *p++ = ',';
+                *p++ = '1'; // 信号标识：L1
+                p = gen_finish(start, p);
+                gen->sat_offsets[++n] = (uint16_t) (p - base);
+            }
+        }
+    }
+    gen->sat_sentences = n;
+}
+
+void gps_gen_default_config(gps_gen_config_t* config) {
+    memset(config, 0, sizeof(gps_gen_config_t));
+    config->seed = 1;
+    config->rate_hz = 1;
+    config->sentence_mask = GPS_GEN_MASK_ALL;
+    memcpy(config->talker, "GN", 3);
+    config->satellites[GPS_GEN_SYSTEM_GPS] = 11;
+    config->satellites[GPS_GEN_SYSTEM_GLONASS] = 8;
+    config->satellites[GPS_GEN_SYSTEM_BEIDOU] = 13;
+    config->start_utc_ns = 1759830165000000000LL; // 2025-10-07 09:42:45
+    config->latitude = 28.742876;
+    config->longitude = 115.870927;
+    config->altitude = 55.2;
+    config->geoid_separation = -6.5;
+    config->speed = 15.0;
+    config->heading = 45.0;
+    config->turn_rate = 0.5;
+    config->speed_noise = 0.2;
+    config->heading_noise = 1.0;
+}
+
+int gps_gen_init(gps_gen_t* gen, const gps_gen_config_t* config) {
+    if (gen == NULL || config == NULL) {
+        return -1;
+    }
+    if (config->rate_hz < 1 || config->rate_hz > 1000 ||
+        config->talker[0] < 'A' || config->talker[0] > 'Z' || config->talker[1] < 'A' || config->talker[1] > 'Z' ||
+        fabs(config->latitude) >= 90.0 || fabs(config->longitude) > 180.0 || config->speed < 0.0) {
+        return -2;
+    }
+    for (int system = 0; system < GPS_GEN_MAX_SYSTEMS; system++) {
+        if (config->satellites[system] < 0 || config->satellites[system] > GPS_GEN_MAX_SATELLITES) {
+            return -2;
+        }
+    }
+    memset(gen, 0, sizeof(gps_gen_t));
+    gen->config = *config;
+    gen->config.talker[2] = '\0';
+    if (gen->config.sat_update_epochs == 0) {
+        gen->config.sat_update_epochs = config->rate_hz;
+    }
+
+    // splitmix64打散种子，保证状态不为0
+    uint64_t z = config->seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    gen->rng = (z ^ (z >> 31)) | 1;
+
+    gen->utc_ns = config->start_utc_ns;
+    gen->step_ns = 1000000000LL / config->rate_hz;
+    gen->dt = 1.0 / config->rate_hz;
+    gen->latitude = config->latitude;
+    gen->longitude = config->longitude;
+    gen->speed = config->speed;
+    gen->heading = config->heading;
+    gen->day_index = INT64_MIN;
+
+    // 每个系统从PRN范围里不重复地抽卫星，按PRN排序
+    for (int system = 0; system < GPS_GEN_MAX_SYSTEMS; system++) {
+        int pool[64];
+        int range = gen_prn_count[system];
+        for (int i = 0; i < range; i++) {
+            pool[i] = gen_prn_first[system] + i;
+        }
+        int count = config->satellites[system] < range ? config->satellites[system] : range;
+        gen->config.satellites[system] = count;
+        for (int i = 0; i < count; i++) {
+            int j = i + (int) (gen_next(gen) % (uint64_t) (range - i));
+            int prn = pool[j];
+            pool[j] = pool[i];
+            pool[i] = prn;
+        }
+        for (int i = 1; i < count; i++) {
+            for (int j = i; j > 0 && pool[j] < pool[j - 1]; j--) {
+                int prn = pool[j];
+                pool[j] = pool[j - 1];
+                pool[j - 1] = prn;
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            gps_gen_satellite_t* sat = &gen->satellites[system][i];
+            sat->prn = pool[i];
+            sat->elevation = 45.0 + 44.0 * gen_uniform(gen);
+            sat->azimuth = 180.0 + 180.0 * gen_uniform(gen);
+            sat->elevation_rate = 0.05 * gen_uniform(gen);
+            sat->azimuth_rate = 0.1 * gen_uniform(gen);
+        }
+    }
+    gen_move_satellites(gen);
+    gen_build_satellite_text(gen);
+    return 0;
+}
+
+// 输出一个历元的全部语句，返回字节数；capacity不足GPS_GEN_EPOCH_MAX返回-3
+int gps_gen_epoch(gps_gen_t* gen, char* out, size_t capacity) {
+    if (gen == NULL || out == NULL) {
+        return -1;
+    }
+    if (capacity < GPS_GEN_EPOCH_MAX) {
+        return -3;
+    }
+    const gps_gen_config_t* config = &gen->config;
+    uint32_t mask = config->sentence_mask;
+
+    if (gen->sat_age >= config->sat_update_epochs) {
+        gen_move_satellites(gen);
+        gen_build_satellite_text(gen);
+        gen->sat_age = 0;
+    }
+    gen->sat_age++;
+
+    // 这个历元共用的字段只格式化一次
+    int64_t day_index = gen->utc_ns / GNSS_NS_PER_DAY;
+    if (gen->utc_ns % GNSS_NS_PER_DAY < 0) {
+        day_index--;
+    }
+    if (day_index != gen->day_index) {
+        gen_update_date(gen, day_index);
+    }
+    uint32_t tod_ms = (uint32_t) ((gen->utc_ns - day_index * GNSS_NS_PER_DAY) / 1000000);
+    char time_text[10];
+    char* t = gen_u2(time_text, tod_ms / 3600000);
+    t = gen_u2(t, tod_ms / 60000 % 60);
+    t = gen_u2(t, tod_ms / 1000 % 60);
+    *t++ = '.';
+    gen_pad(t, tod_ms % 1000, 3);
+
+    char position[32];
+    char* q = gen_angle(position, gen->latitude, 2);
+    *q++ = ',';
+    *q++ = gen->latitude >= 0 ? 'N' : 'S';
+    *q++ = ',';
+    q = gen_angle(q, gen->longitude, 3);
+    *q++ = ',';
+    *q++ = gen->longitude >= 0 ? 'E' : 'W';
+    size_t position_len = (size_t) (q - position);
+
+    int valid = gen->used_count >= 4;
+    int64_t knots100 = llround(gen->speed * GEN_MS_TO_KNOTS * 100.0);
+    int64_t kmh100 = llround(gen->speed * GEN_MS_TO_KMH * 100.0);
+    int64_t course100 = llround(gen->heading * 100.0) % 36000;
+
+    char* p = out;
+    char* start;
+    if (mask & GPS_GEN_MASK(GPS_SENTENCE_GGA)) {
+        start = p;
+        p = gen_begin(p, config->talker, "GGA");
+        memcpy(p, time_text, 10);
+        p += 10;
+        *p++ = ',';
+        memcpy(p, position, position_len);
+        p += position_len;
+        *p++ = ',';
+        *p++ = valid ? '1' : '0';
+        *p++ = ',';
+        p = gen_u2(p, (uint32_t) (gen->used_count < 99 ? gen->used_count : 99));
+        *p++ = ',';
+        p = gen_fixed(p, gen->hdop10, 1);
+        *p++ = ',';
+        p = gen_fixed(p, llround(config->altitude * 10.0), 1);
+        *p++ = ',';
+        *p++ = 'M';
+        *p++ = ',';
+        p = gen_fixed(p, llround(config->geoid_separation * 10.0), 1);
+        memcpy(p, ",M,,", 4);
+        p = gen_finish(start, p + 4);
+        p = gen_emit(gen, start, p);
+    }
+    if (mask & GPS_GEN_MASK(GPS_SENTENCE_GLL)) {
+        start = p;
+        p = gen_begin(p, config->talker, "GLL");
+        memcpy(p, position, position_len);
+        p += position_len;
+        *p++ = ',';
+        memcpy(p, time_text, 10);
+        p += 10;
+        *p++ = ',';
+        *p++ = valid ? 'A' : 'V';
+        *p++ = ',';
+        *p++ = valid ? 'A' : 'N';
+        p = gen_finish(start, p);
+        p = gen_emit(gen, start, p);
+    }
+    for (int i = 0; i < gen->sat_sentences; i++) {
+        size_t len = (size_t) (gen->sat_offsets[i + 1] - gen->sat_offsets[i]);
+        memcpy(p, gen->sat_text + gen->sat_offsets[i], len);
+        start = p;
+        p = gen_emit(gen, start, p + len);
+    }
+    if (mask & GPS_GEN_MASK(GPS_SENTENCE_RMC)) {
+        start = p;
+        p = gen_begin(p, config->talker, "RMC");
+        memcpy(p, time_text, 10);
+        p += 10;
+        *p++ = ',';
+        *p++ = valid ? 'A' : 'V';
+        *p++ = ',';
+        memcpy(p, position, position_len);
+        p += position_len;
+        *p++ = ',';
+        p = gen_fixed(p, knots100, 2);
+        *p++ = ',';
+        p = gen_fixed(p, course100, 2);
+        *p++ = ',';
+        memcpy(p, gen->rmc_date, 6);
+        p += 6;
+        memcpy(p, ",,,", 3);
+        p += 3;
+        *p++ = valid ? 'A' : 'N';
+        *p++ = ',';
+        *p++ = 'V';
+        p = gen_finish(start, p);
+        p = gen_emit(gen, start, p);
+    }
+    if (mask & GPS_GEN_MASK(GPS_SENTENCE_VTG)) {
+        start = p;
+        p = gen_begin(p, config->talker, "VTG");
+        p = gen_fixed(p, course100, 2);
+        memcpy(p, ",T,,M,", 6);
+        p = gen_fixed(p + 6, knots100, 2);
+        memcpy(p, ",N,", 3);
+        p = gen_fixed(p + 3, kmh100, 2);
+        memcpy(p, ",K,", 3);
+        p += 3;
+        *p++ = valid ? 'A' : 'N';
+        p = gen_finish(start, p);
+        p = gen_emit(gen, start, p);
+    }
+    if (mask & GPS_GEN_MASK(GPS_SENTENCE_ZDA)) {
+        start = p;
+        p = gen_begin(p, config->talker, "ZDA");
+        memcpy(p, time_text, 10);
+        p += 10;
+        *p++ = ',';
+        memcpy(p, gen->zda_date, 10);
+        p += 10;
+        memcpy(p, ",00,00", 6);
+        p = gen_finish(start, p + 6);
+        p = gen_emit(gen, start, p);
+    }
+    // TXT每秒一条
+    if ((mask & GPS_GEN_MASK(GPS_SENTENCE_TXT)) && gen->epoch % config->rate_hz == 0) {
+        start = p;
+        p = gen_begin(p, "GP", "TXT");
+        memcpy(p, "01,01,02,SIMULATED", 18);
+        p = gen_finish(start, p + 18);
+        p = gen_emit(gen, start, p);
+    }
+
+    // 推进到下一个历元
+    double dt = gen->dt;
+    double root_dt = sqrt(dt);
+    gen->speed += config->speed_noise * root_dt * gen_uniform(gen);
+    if (gen->speed < 0.0) {
+        gen->speed = -gen->speed;
+    }
+    gen->heading += config->turn_rate * dt + config->heading_noise * root_dt * gen_uniform(gen);
+    double distance = gen->speed * dt;
+    gen->latitude += distance * cos(gen->heading * GEN_DEG) / GEN_EARTH_RADIUS / GEN_DEG;
+    gen->longitude += distance * sin(gen->heading * GEN_DEG) / (GEN_EARTH_RADIUS * cos(gen->latitude * GEN_DEG)) / GEN_DEG;
+    if (fabs(gen->latitude) > 89.0) {
+        gen->latitude = gen->latitude > 0 ? 89.0 : -89.0;
+        gen->heading = 180.0 - gen->heading; // 到极区就掉头
+    }
+    if (gen->longitude >= 180.0) {
+        gen->longitude -= 360.0;
+    } else if (gen->longitude < -180.0) {
+        gen->longitude += 360.0;
+    }
+    gen->heading = fmod(gen->heading, 360.0);
+    if (gen->heading < 0.0) {
+        gen->heading += 360.0;
+    }
+    gen->utc_ns += gen->step_ns;
+    gen->epoch++;
+
+    int len = (int) (p - out);
+    gen->stats.epochs++;
+    gen->stats.bytes += (uint64_t) len;
+    return len;
+}
+
+// 填满尽量多的整历元，返回写入的字节数
+size_t gps_gen_fill(gps_gen_t* gen, char* out, size_t capacity) {
+    size_t used = 0;
+    while (capacity - used >= GPS_GEN_EPOCH_MAX) {
+        int len = gps_gen_epoch(gen, out + used, capacity - used);
+        if (len < 0) {
+            break;
+        }
+        used += (size_t) len;
+    }
+    return used;
+}
+
+void gps_gen_get_stats(const gps_gen_t* gen, gps_gen_stats_t* stats) {
+    *stats = gen->stats;
+}
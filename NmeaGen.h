@@ -0,0 +1,126 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_NMEAGEN_H
+#define NMEA0183_NMEAGEN_H
+#include <stddef.h>
+#include <stdint.h>
+#include "Metrics.h"
+
+// 合成NMEA数据流，用于压力测试和长时间运行测试
+// 模拟一条轨迹（速度、航向、转弯率加随机扰动）和若干星座的卫星，每个历元输出时间、位置互相一致的
+// GGA/RMC/VTG/GLL/ZDA/GSA/GSV/TXT；可以按比例注入错误校验和、截断的语句和乱码
+// 同一个种子输出的字节流完全相同，出问题时可以复现
+// 为了跑到每秒数千万条：全部整数格式化、不调用printf；卫星每gps_gen_config_t.sat_update_epochs个历元
+// 才变化一次，GSA/GSV只在那时重新生成，其余历元直接复制缓存的文本
+
+#define GPS_GEN_SYSTEM_GPS 0
+#define GPS_GEN_SYSTEM_GLONASS 1
+#define GPS_GEN_SYSTEM_GALILEO 2
+#define GPS_GEN_SYSTEM_BEIDOU 3
+#define GPS_GEN_MAX_SYSTEMS 4
+
+#define GPS_GEN_MAX_SATELLITES 32  // 每个系统最多这么多颗可见卫星（GSV最多8条）
+#define GPS_GEN_GSA_MAX 12         // GSA里最多12颗
+#define GPS_GEN_GARBAGE_MAX 32     // 每次注入的乱码最多这么多字节
+#define GPS_GEN_SENTENCE_MAX 96    // 一条语句（含行尾）的上限，NMEA规定不超过82
+#define GPS_GEN_EPOCH_SENTENCES (6 + GPS_GEN_MAX_SYSTEMS * (1 + GPS_GEN_MAX_SATELLITES / 4))
+// 一个历元最多输出的字节数，gps_gen_epoch的缓冲区至少这么大
+#define GPS_GEN_EPOCH_MAX (GPS_GEN_EPOCH_SENTENCES * (GPS_GEN_SENTENCE_MAX + GPS_GEN_GARBAGE_MAX))
+
+// sentence_mask按Metrics.h的语句类型编号取位
+#define GPS_GEN_MASK(type) (1u << (type))
+#define GPS_GEN_MASK_ALL (GPS_GEN_MASK(GPS_SENTENCE_GGA) | GPS_GEN_MASK(GPS_SENTENCE_GLL) | \
+                          GPS_GEN_MASK(GPS_SENTENCE_GSA) | GPS_GEN_MASK(GPS_SENTENCE_GSV) | \
+                          GPS_GEN_MASK(GPS_SENTENCE_RMC) | GPS_GEN_MASK(GPS_SENTENCE_VTG) | \
+                          GPS_GEN_MASK(GPS_SENTENCE_ZDA) | GPS_GEN_MASK(GPS_SENTENCE_TXT))
+
+typedef struct {
+    uint64_t seed;             // 随机种子，相同配置+相同种子输出相同
+    uint32_t rate_hz;          // 每秒历元数（1~1000），决定时间戳步长
+    uint32_t sentence_mask;    // 输出哪些语句
+    char talker[3];            // GGA/RMC/VTG/GLL/ZDA/GSA的发送者标识，如"GN"；GSV用各系统自己的
+    int satellites[GPS_GEN_MAX_SYSTEMS]; // 每个系统的可见卫星数（0~GPS_GEN_MAX_SATELLITES），0表示不输出该系统
+
+    // 轨迹
+    int64_t start_utc_ns;      // 第一个历元的UTC时间（Unix纪元纳秒）
+    double latitude;           // 起点，度，北正南负
+    double longitude;          // 起点，度，东正西负
+    double altitude;           // 海拔，米
+    double geoid_separation;   // 大地水准面差距，米
+    double speed;              // 初始速度，米/秒
+    double heading;            // 初始航向，度
+    double turn_rate;          // 转弯率，度/秒
+    double speed_noise;        // 每秒速度随机变化的幅度，米/秒
+    double heading_noise;      // 每秒航向随机变化的幅度，度
+
+    uint32_t sat_update_epochs;// 卫星状态每多少个历元更新一次，0表示每秒一次
+
+    // 错误注入，按每百万条语句计
+    uint32_t bad_checksum_ppm; // 校验和错一位
+    uint32_t truncate_ppm;     // 从中间截断（没有校验和，至少保留"$xxYYY,"）
+    uint32_t garbage_ppm;      // 语句后面跟一段随机字节（不含'$'、'!'、行尾和UBX/RTCM3同步字）
+} gps_gen_config_t;
+
+// 和解析端的统计一一对应（没有卫星表溢出时）：bad_checksums = GPS_OUTCOME_CHECKSUM_FAILED，
+// truncated = GPS_OUTCOME_TRUNCATED，其余语句都是GPS_OUTCOME_PARSED，garbage_bytes = unframed_bytes
+typedef struct {
+    uint64_t epochs;
+    uint64_t sentences;        // 输出的语句数（含注入了错误的）
+    uint64_t bytes;
+    uint64_t bad_checksums;
+    uint64_t truncated;
+    uint64_t garbage;          // 注入乱码的次数
+    uint64_t garbage_bytes;    // 注入的乱码字节数
+} gps_gen_stats_t;
+
+typedef struct {
+    int prn;
+    double elevation;          // 度
+    double azimuth;            // 度
+    double elevation_rate;     // 度/次更新
+    double azimuth_rate;
+    int snr;                   // dBHz，0表示没有信号
+} gps_gen_satellite_t;
+
+typedef struct {
+    gps_gen_config_t config;
+    uint64_t rng;
+    uint64_t epoch;
+    int64_t utc_ns;
+    int64_t step_ns;
+    double dt;                 // 历元间隔，秒
+
+    double latitude;
+    double longitude;
+    double speed;
+    double heading;
+
+    // 当天的日期文本，只有跨天时才重新生成
+    int64_t day_index;
+    char zda_date[12];         // "dd,mm,yyyy"
+    char rmc_date[7];          // "ddmmyy"
+
+    gps_gen_satellite_t satellites[GPS_GEN_MAX_SYSTEMS][GPS_GEN_MAX_SATELLITES];
+    int used_count;            // 参与定位（仰角够高且有信号）的卫星数
+    int hdop10;                // 精度因子×10
+    int pdop10;
+    int vdop10;
+
+    // GSA/GSV文本缓存
+    char sat_text[(GPS_GEN_MAX_SYSTEMS * (1 + GPS_GEN_MAX_SATELLITES / 4)) * GPS_GEN_SENTENCE_MAX];
+    uint16_t sat_offsets[GPS_GEN_MAX_SYSTEMS * (1 + GPS_GEN_MAX_SATELLITES / 4) + 1];
+    int sat_sentences;
+    uint32_t sat_age;          // 距上次更新卫星的历元数
+
+    gps_gen_stats_t stats;
+} gps_gen_t;
+
+void gps_gen_default_config(gps_gen_config_t* config);
+int gps_gen_init(gps_gen_t* gen, const gps_gen_config_t* config);
+int gps_gen_epoch(gps_gen_t* gen, char* out, size_t capacity);
+size_t gps_gen_fill(gps_gen_t* gen, char* out, size_t capacity);
+void gps_gen_get_stats(const gps_gen_t* gen, gps_gen_stats_t* stats);
+
+#endif // NMEA0183_NMEAGEN_H
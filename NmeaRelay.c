@@ -0,0 +1,329 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "NmeaRelay.h"
+
+#if GPS_ENABLE_RELAY
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "Metrics.h"
+
+_Static_assert((GPS_RELAY_BACKLOG & (GPS_RELAY_BACKLOG - 1)) == 0, "GPS_RELAY_BACKLOG must be a power of two");
+
+// epoll事件的data：TCP客户端用下标，监听socket和UDP socket用下面两个值
+#define RELAY_TAG_LISTEN GPS_RELAY_MAX_CLIENTS
+#define RELAY_TAG_UDP (GPS_RELAY_MAX_CLIENTS + 1)
+#define RELAY_MASK (GPS_RELAY_BACKLOG - 1)
+
+// 积压缓冲区中[from, to)对应的一到两段
+static int relay_iov(gps_relay_t* relay, uint64_t from, uint64_t to, struct iovec iov[2]) {
+    size_t start = (size_t) (from & RELAY_MASK);
+    size_t len = (size_t) (to - from);
+    size_t first = GPS_RELAY_BACKLOG - start;
+    if (first > len) {
+        first = len;
+    }
+    iov[0].iov_base = relay->backlog + start;
+    iov[0].iov_len = first;
+    iov[1].iov_base = relay->backlog;
+    iov[1].iov_len = len - first;
+    return iov[1].iov_len > 0 ? 2 : 1;
+}
+
+static int relay_socket(const char* bind_address, uint16_t port, int type) {
+    struct sockaddr_in addr = {.sin_family = AF_INET, .sin_port = htons(port)};
+    if (inet_pton(AF_INET, bind_address != NULL ? bind_address : "127.0.0.1", &addr.sin_addr) != 1) {
+        return -1;
+    }
+    int fd = socket(AF_INET, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(fd, (struct sockaddr*) &addr, sizeof(addr)) != 0 || (type == SOCK_STREAM && listen(fd, 64) != 0)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int relay_watch(gps_relay_t* relay, int fd, uint32_t events, uint32_t tag, int op) {
+    struct epoll_event event = {.events = events, .data.u32 = tag};
+    return epoll_ctl(relay->epoll_fd, op, fd, &event);
+}
+
+// 打开监听端口，端口号为0表示不开这种协议；bind_address为NULL时只监听本机
+// 返回：0=成功，-1=空指针，-2=epoll创建失败，-3=TCP端口打开失败，-4=UDP端口打开失败
+int gps_relay_open(gps_relay_t* relay, const char* bind_address, uint16_t tcp_port, uint16_t udp_port) {
+    if (relay == NULL) {
+        return -1;
+    }
+    memset(&relay->stats, 0, sizeof(relay->stats));
+    relay->head = 0;
+    relay->tcp_fd = -1;
+    relay->udp_fd = -1;
+    for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+        relay->tcp[i].fd = -1;
+        relay->udp[i].expires_ns = 0;
+    }
+    relay->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (relay->epoll_fd < 0) {
+        return -2;
+    }
+    if (tcp_port != 0) {
+        relay->tcp_fd = relay_socket(bind_address, tcp_port, SOCK_STREAM);
+        if (relay->tcp_fd < 0 || relay_watch(relay, relay->tcp_fd, EPOLLIN, RELAY_TAG_LISTEN, EPOLL_CTL_ADD) != 0) {
+            gps_relay_close(relay);
+            return -3;
+        }
+    }
+    if (udp_port != 0) {
+        relay->udp_fd = relay_socket(bind_address, udp_port, SOCK_DGRAM);
+        if (relay->udp_fd < 0 || relay_watch(relay, relay->udp_fd, EPOLLIN, RELAY_TAG_UDP, EPOLL_CTL_ADD) != 0) {
+            gps_relay_close(relay);
+            return -4;
+        }
+    }
+    return 0;
+}
+
+static void relay_drop_tcp(gps_relay_t* relay, int index) {
+    gps_relay_tcp_client_t* client = &relay->tcp[index];
+    epoll_ctl(relay->epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    client->fd = -1;
+}
+
+// 把客户端落后的数据尽量发出去；发不完就等EPOLLOUT，出错就断开
+static void relay_flush_tcp(gps_relay_t* relay, int index) {
+    gps_relay_tcp_client_t* client = &relay->tcp[index];
+    while (client->cursor != relay->head) {
+        struct iovec iov[2];
+        struct msghdr msg = {.msg_iov = iov};
+        msg.msg_iovlen = (size_t) relay_iov(relay, client->cursor, relay->head, iov);
+        ssize_t n = sendmsg(client->fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            relay_drop_tcp(relay, index);
+            return;
+        }
+        client->cursor += (uint64_t) n;
+    }
+    int want_write = client->cursor != relay->head;
+    if (want_write != client->want_write) {
+        relay_watch(relay, client->fd, want_write ? EPOLLIN | EPOLLOUT : EPOLLIN, (uint32_t) index, EPOLL_CTL_MOD);
+        client->want_write = want_write;
+    }
+}
+
+// 转发一条语句（不含行尾，会补上\r\n）
+// 返回：0=成功，-1=空指针，-2=语句比积压缓冲区还长
+int gps_relay_push(gps_relay_t* relay, const char* sentence, uint32_t len) {
+    if (relay == NULL || sentence == NULL) {
+        return -1;
+    }
+    uint64_t total = (uint64_t) len + 2;
+    if (total > GPS_RELAY_BACKLOG) {
+        return -2;
+    }
+    uint64_t from = relay->head;
+    uint64_t to = from + total;
+
+    // 写入前先断开还没发完、马上要被覆盖的客户端
+    for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+        if (relay->tcp[i].fd >= 0 && to - relay->tcp[i].cursor > GPS_RELAY_BACKLOG) {
+            relay_drop_tcp(relay, i);
+            relay->stats.tcp_dropped++;
+        }
+    }
+
+    struct iovec iov[2];
+    int count = relay_iov(relay, from, to, iov);
+    size_t first = len < iov[0].iov_len ? len : iov[0].iov_len;
+    memcpy(iov[0].iov_base, sentence, first);
+    if (count == 2) {
+        memcpy(iov[1].iov_base, sentence + first, len - first);
+    }
+    relay->backlog[(from + len) & RELAY_MASK] = '\r';
+    relay->backlog[(from + len + 1) & RELAY_MASK] = '\n';
+    relay->head = to;
+    relay->stats.sentences++;
+    relay->stats.bytes += total;
+
+    for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+        if (relay->tcp[i].fd >= 0 && !relay->tcp[i].want_write) {
+            relay_flush_tcp(relay, i); // 已经在等EPOLLOUT的客户端由poll补发
+        }
+    }
+
+    if (relay->udp_fd >= 0) {
+        uint64_t now = gps_monotonic_ns();
+        for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+            gps_relay_udp_client_t* client = &relay->udp[i];
+            if (client->expires_ns == 0) {
+                continue;
+            }
+            if (client->expires_ns < now) {
+                client->expires_ns = 0;
+                continue;
+            }
+            struct msghdr msg = {.msg_name = &client->addr, .msg_namelen = client->addr_len,
+                                 .msg_iov = iov, .msg_iovlen = (size_t) count};
+            if (sendmsg(relay->udp_fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT) < 0) {
+                relay->stats.udp_dropped++;
+            } else {
+                relay->stats.udp_sent++;
+            }
+        }
+    }
+    return 0;
+}
+
+// 可以直接传给set_sentence_handler，user是gps_relay_t*
+void gps_relay_sentence_handler(const char* sentence, uint32_t len, void* user) {
+    gps_relay_push((gps_relay_t*) user, sentence, len);
+}
+
+static void relay_accept(gps_relay_t* relay) {
+    for (;;) {
+        int fd = accept(relay->tcp_fd, NULL, NULL);
+        if (fd < 0) {
+            return;
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        int index = 0;
+        while (index < GPS_RELAY_MAX_CLIENTS && relay->tcp[index].fd >= 0) {
+            index++;
+        }
+        if (index == GPS_RELAY_MAX_CLIENTS || relay_watch(relay, fd, EPOLLIN, (uint32_t) index, EPOLL_CTL_ADD) != 0) {
+            close(fd);
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        relay->tcp[index].fd = fd;
+        relay->tcp[index].cursor = relay->head; // 新客户端从下一条语句开始收
+        relay->tcp[index].want_write = 0;
+        relay->stats.tcp_accepted++;
+    }
+}
+
+// UDP订阅：记下（或刷新）发送方地址
+static void relay_subscribe(gps_relay_t* relay) {
+    for (;;) {
+        char scratch[64];
+        struct sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+        if (recvfrom(relay->udp_fd, scratch, sizeof(scratch), MSG_DONTWAIT, (struct sockaddr*) &addr, &addr_len) < 0) {
+            return;
+        }
+        uint64_t now = gps_monotonic_ns();
+        int slot = -1;
+        for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+            gps_relay_udp_client_t* client = &relay->udp[i];
+            if (client->expires_ns >= now && client->addr_len == addr_len &&
+                memcmp(&client->addr, &addr, addr_len) == 0) {
+                slot = i;
+                break;
+            }
+            if (slot < 0 && client->expires_ns < now) {
+                slot = i; // 空闲或已过期的槽位，找不到同一地址时用
+            }
+        }
+        if (slot < 0) {
+            continue;
+        }
+        relay->udp[slot].addr = addr;
+        relay->udp[slot].addr_len = addr_len;
+        relay->udp[slot].expires_ns = now + (uint64_t) GPS_RELAY_UDP_TTL_MS * 1000000ull;
+    }
+}
+
+// 处理新连接、UDP订阅、可写的慢客户端和断开的客户端
+// 返回：处理的事件数，-1=空指针，-2=epoll_wait失败
+int gps_relay_poll(gps_relay_t* relay, int timeout_ms) {
+    if (relay == NULL) {
+        return -1;
+    }
+    struct epoll_event events[GPS_RELAY_EVENTS];
+    int count = epoll_wait(relay->epoll_fd, events, GPS_RELAY_EVENTS, timeout_ms);
+    if (count < 0) {
+        return errno == EINTR ? 0 : -2;
+    }
+    for (int i = 0; i < count; i++) {
+        uint32_t tag = events[i].data.u32;
+        if (tag == RELAY_TAG_LISTEN) {
+            relay_accept(relay);
+        } else if (tag == RELAY_TAG_UDP) {
+            relay_subscribe(relay);
+        } else if (relay->tcp[tag].fd >= 0) {
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                // 客户端不应该发数据，读到EOF或出错说明对端已关闭，其它内容丢掉
+                char scratch[256];
+                ssize_t n = recv(relay->tcp[tag].fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EINTR)) {
+                    relay_drop_tcp(relay, (int) tag);
+                    continue;
+                }
+            }
+            if (events[i].events & EPOLLOUT) {
+                relay_flush_tcp(relay, (int) tag);
+            }
+        }
+    }
+    return count;
+}
+
+// 当前TCP连接数加有效的UDP订阅数
+int gps_relay_client_count(const gps_relay_t* relay) {
+    if (relay == NULL) {
+        return -1;
+    }
+    uint64_t now = gps_monotonic_ns();
+    int count = 0;
+    for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+        count += relay->tcp[i].fd >= 0;
+        count += relay->udp[i].expires_ns >= now;
+    }
+    return count;
+}
+
+void gps_relay_close(gps_relay_t* relay) {
+    if (relay == NULL) {
+        return;
+    }
+    for (int i = 0; i < GPS_RELAY_MAX_CLIENTS; i++) {
+        if (relay->tcp[i].fd >= 0) {
+            relay_drop_tcp(relay, i);
+        }
+        relay->udp[i].expires_ns = 0;
+    }
+    if (relay->tcp_fd >= 0) {
+        close(relay->tcp_fd);
+        relay->tcp_fd = -1;
+    }
+    if (relay->udp_fd >= 0) {
+        close(relay->udp_fd);
+        relay->udp_fd = -1;
+    }
+    if (relay->epoll_fd >= 0) {
+        close(relay->epoll_fd);
+        relay->epoll_fd = -1;
+    }
+}
+#endif
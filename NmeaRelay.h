@@ -0,0 +1,76 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_NMEARELAY_H
+#define NMEA0183_NMEARELAY_H
+#include <stdint.h>
+
+// 把校验通过的NMEA语句转发给多个TCP/UDP客户端（海图软件、记录仪、远程诊断）
+// 所有语句只复制一次，进共享的积压缓冲区（按位置递增的字节环），每个TCP客户端只记自己发到的位置，
+// 用sendmsg分散写直接从积压缓冲区发送；UDP每条语句一个数据报，同样直接指向积压缓冲区
+// 发不出去的TCP客户端等EPOLLOUT再补发，落后超过积压缓冲区（数据将被覆盖）时直接断开，不会拖住解析
+// UDP客户端向服务端口发任意数据报即订阅，GPS_RELAY_UDP_TTL_MS内没有再发就过期
+// 单线程：gps_relay_push和gps_relay_poll都在solve_once所在线程调用
+
+#ifndef GPS_ENABLE_RELAY
+#ifdef __linux__
+#define GPS_ENABLE_RELAY 1
+#else
+#define GPS_ENABLE_RELAY 0
+#endif
+#endif
+
+#ifndef GPS_RELAY_BACKLOG
+#define GPS_RELAY_BACKLOG 65536    // 积压缓冲区大小，必须是2的幂
+#endif
+#ifndef GPS_RELAY_MAX_CLIENTS
+#define GPS_RELAY_MAX_CLIENTS 128  // TCP、UDP各自的最大客户端数
+#endif
+#define GPS_RELAY_UDP_TTL_MS 30000
+#define GPS_RELAY_EVENTS 32
+
+#if GPS_ENABLE_RELAY
+#include <sys/socket.h>
+
+typedef struct {
+    int fd;                    // -1表示空闲
+    uint64_t cursor;           // 已发送到积压缓冲区的哪个位置
+    int want_write;            // 已登记EPOLLOUT
+} gps_relay_tcp_client_t;
+
+typedef struct {
+    struct sockaddr_storage addr;
+    socklen_t addr_len;
+    uint64_t expires_ns;       // 0表示空闲
+} gps_relay_udp_client_t;
+
+typedef struct {
+    uint64_t sentences;        // 转发的语句数
+    uint64_t bytes;            // 写进积压缓冲区的字节数
+    uint64_t tcp_accepted;
+    uint64_t tcp_dropped;      // 因落后太多被断开的TCP客户端
+    uint64_t udp_sent;         // 发出的数据报
+    uint64_t udp_dropped;      // 发送失败（缓冲区满等）的数据报
+} gps_relay_stats_t;
+
+typedef struct {
+    int epoll_fd;
+    int tcp_fd;                // -1表示不监听TCP
+    int udp_fd;                // -1表示不监听UDP
+    uint64_t head;             // 写进积压缓冲区的总字节数
+    char backlog[GPS_RELAY_BACKLOG];
+    gps_relay_tcp_client_t tcp[GPS_RELAY_MAX_CLIENTS];
+    gps_relay_udp_client_t udp[GPS_RELAY_MAX_CLIENTS];
+    gps_relay_stats_t stats;
+} gps_relay_t;
+
+int gps_relay_open(gps_relay_t* relay, const char* bind_address, uint16_t tcp_port, uint16_t udp_port);
+int gps_relay_push(gps_relay_t* relay, const char* sentence, uint32_t len);
+void gps_relay_sentence_handler(const char* sentence, uint32_t len, void* user);
+int gps_relay_poll(gps_relay_t* relay, int timeout_ms);
+int gps_relay_client_count(const gps_relay_t* relay);
+void gps_relay_close(gps_relay_t* relay);
+#endif
+
+#endif // NMEA0183_NMEARELAY_H
@@ -0,0 +1,87 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "ParseCache.h"
+
+#if GPS_ENABLE_PARSE_CACHE
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+// 计算语句的缓存键，time_field是时间字段的序号（语句头之后从1开始，0表示没有时间字段）
+// 返回1=和memo里记的相同，0=不同，-1=语句没有'*'或超长（交给解析函数按原来的方式报错，不要记下）
+int gps_memo_lookup(const gps_parse_memo_t* memo, const char* sentence, int time_field, gps_memo_key_t* key) {
+    const char* p = sentence + 1;
+    const char* end = sentence + NMEA_MAX_SENTENCE + 1; // 和解析函数的缓冲区长度限制一致
+    uint64_t hash = FNV_OFFSET_BASIS;
+    uint16_t length = 0;
+    int field = 0;
+    int time_len = 0;
+
+    key->time_str[0] = '\0';
+    for (; p < end && *p != '*'; p++) {
+        if (*p == '\0') {
+            return -1;
+        }
+        if (*p == ',') {
+            if (field == time_field && time_field > 0) {
+                key->time_str[time_len] = '\0'; // 时间字段后面有逗号才算数，和strtok_my一致
+            }
+            field++;
+        } else if (field == time_field && time_field > 0) {
+            if (time_len < (int) sizeof(key->time_str) - 1) {
+                key->time_str[time_len++] = *p;
+            }
+            continue;
+        }
+        hash = (hash ^ (uint8_t) *p) * FNV_PRIME;
+        length++;
+    }
+    if (p >= end) {
+        return -1;
+    }
+    if (field <= time_field) {
+        key->time_str[0] = '\0'; // 时间是最后一个字段，解析函数不会读它
+    }
+
+    key->hash = hash;
+    key->length = length;
+    return memo->valid && memo->hash == hash && memo->length == length;
+}
+
+void gps_memo_store(gps_parse_memo_t* memo, const gps_memo_key_t* key) {
+    memo->hash = key->hash;
+    memo->length = key->length;
+    memo->valid = 1;
+}
+
+void gps_memo_invalidate(gps_parse_memo_t* memo) {
+    memo->valid = 0;
+}
+
+// 按解析函数的规则重新解析时间字段（hhmmss.sss），返回has_time
+int gps_memo_refresh_time(const char* time_str, int check_range, int* hour, int* minute, gps_second_t* second,
+                          gps_tod_t* utc_time) {
+    *hour = 0;
+    *minute = 0;
+    *second = 0;
+    *utc_time = -1.0;
+    if (strlen(time_str) < 6) {
+        return 0;
+    }
+    int hours, minutes;
+    gps_second_t seconds;
+    if (GPS_PARSE_HMS(time_str, &hours, &minutes, &seconds) < 2) {
+        return 0;
+    }
+    if (check_range && !(hours >= 0 && hours <= 23 && minutes >= 0 && minutes <= 59 &&
+                         seconds >= 0 && seconds < GPS_CONST(60.0, SECOND))) {
+        return 0;
+    }
+    *hour = hours;
+    *minute = minutes;
+    *second = seconds;
+    *utc_time = GPS_UTC_TIME(hours, minutes, seconds);
+    return 1;
+}
+#endif
@@ -0,0 +1,34 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_PARSECACHE_H
+#define NMEA0183_PARSECACHE_H
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+
+// 解析缓存：每个解析结果槽位（gga、rmc、每条gsa/gsv……）记下产生当前结果的语句内容的哈希，
+// 新语句哈希相同时槽位里已经是正确的结果，不用再解析
+// 带时间的语句（GGA/RMC/GLL/ZDA）每个历元通常只有时间在变，哈希时跳过时间字段，命中后只重新解析时间
+// 解析失败时调用方要让槽位失效
+// 编译时用 -DGPS_ENABLE_PARSE_CACHE=1 打开
+
+typedef struct {
+    uint64_t hash;      // 语句$与*之间内容（除时间字段）的FNV-1a哈希
+    uint16_t length;    // 参与哈希的字节数，进一步降低误判
+    uint8_t valid;
+} gps_parse_memo_t;
+
+typedef struct {
+    uint64_t hash;
+    uint16_t length;
+    char time_str[16];  // 跳过的时间字段，和解析函数一样最多取15个字符
+} gps_memo_key_t;
+
+int gps_memo_lookup(const gps_parse_memo_t* memo, const char* sentence, int time_field, gps_memo_key_t* key);
+void gps_memo_store(gps_parse_memo_t* memo, const gps_memo_key_t* key);
+void gps_memo_invalidate(gps_parse_memo_t* memo);
+int gps_memo_refresh_time(const char* time_str, int check_range, int* hour, int* minute, gps_second_t* second,
+                          gps_tod_t* utc_time);
+
+#endif // NMEA0183_PARSECACHE_H
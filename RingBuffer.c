@@ -0,0 +1,171 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "RingBuffer.h"
+#include <string.h>
+
+int gps_ring_init(gps_ring_t* ring, char* storage, size_t capacity, int policy) {
+    if (ring == NULL || storage == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return -1;
+    }
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    ring->buffer = storage;
+    ring->capacity = capacity;
+    ring->mask = capacity - 1;
+    atomic_init(&ring->policy, policy);
+    atomic_init(&ring->written_bytes, 0);
+    atomic_init(&ring->read_bytes, 0);
+    atomic_init(&ring->dropped_writes, 0);
+    atomic_init(&ring->dropped_bytes, 0);
+    atomic_init(&ring->overwritten_bytes, 0);
+    return 0;
+}
+
+void gps_ring_set_policy(gps_ring_t* ring, int policy) {
+    atomic_store_explicit(&ring->policy, policy, memory_order_relaxed);
+}
+
+// 生产者：为len字节腾出空间，按溢出策略处理空间不足；返回0表示可以写入，-2表示本次写入被丢弃
+int gps_ring_reserve(gps_ring_t* ring, size_t len) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    int policy = atomic_load_explicit(&ring->policy, memory_order_relaxed);
+
+    if (len > ring->capacity) {
+        atomic_fetch_add_explicit(&ring->dropped_writes, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&ring->dropped_bytes, len, memory_order_relaxed);
+        return -2;
+    }
+
+    for (;;) {
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        size_t free_space = ring->capacity - (head - tail);
+        if (free_space >= len) {
+            return 0;
+        }
+
+        switch (policy) {
+            case GPS_RING_DROP_OLDEST: {
+                // 推进tail丢掉最旧的数据；与消费者竞争失败说明消费者刚读走了一部分，重新计算即可
+                size_t new_tail = head + len - ring->capacity;
+                if (atomic_compare_exchange_weak_explicit(&ring->tail, &tail, new_tail,
+                                                          memory_order_acq_rel, memory_order_acquire)) {
+                    atomic_fetch_add_explicit(&ring->overwritten_bytes, new_tail - tail, memory_order_relaxed);
+                    return 0;
+                }
+                break;
+            }
+            case GPS_RING_BLOCK:
+                GPS_RING_RELAX();
+                break;
+            default:
+                atomic_fetch_add_explicit(&ring->dropped_writes, 1, memory_order_relaxed);
+                atomic_fetch_add_explicit(&ring->dropped_bytes, len, memory_order_relaxed);
+                return -2;
+        }
+    }
+}
+
+// 生产者：把数据复制到head之后offset处（还未发布）
+void gps_ring_put(gps_ring_t* ring, size_t offset, const char* data, size_t len) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t start = (head + offset) & ring->mask;
+    size_t first = ring->capacity - start;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(ring->buffer + start, data, first);
+    memcpy(ring->buffer, data + first, len - first);
+}
+
+// 生产者：发布已写入的len字节
+void gps_ring_commit(gps_ring_t* ring, size_t len) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    atomic_store_explicit(&ring->head, head + len, memory_order_release);
+    atomic_fetch_add_explicit(&ring->written_bytes, len, memory_order_relaxed);
+}
+
+// 生产者：整体写入，要么全部写入，要么全部丢弃；返回写入的字节数
+size_t gps_ring_write(gps_ring_t* ring, const char* data, size_t len) {
+    if (gps_ring_reserve(ring, len) != 0) {
+        return 0;
+    }
+    gps_ring_put(ring, 0, data, len);
+    gps_ring_commit(ring, len);
+    return len;
+}
+
+// 生产者：head之后的空闲空间，绕回时分成两段，返回总字节数
+// 可以直接把数据读进这两段（比如readv），再用commit发布实际写入的长度，省掉一次复制
+size_t gps_ring_free_spans(gps_ring_t* ring, gps_ring_span_t spans[2]) {
+    size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t free_space = ring->capacity - (head - tail);
+    size_t start = head & ring->mask;
+    size_t first = ring->capacity - start;
+    if (first > free_space) {
+        first = free_space;
+    }
+    spans[0].data = ring->buffer + start;
+    spans[0].len = first;
+    spans[1].data = ring->buffer;
+    spans[1].len = free_space - first;
+    return free_space;
+}
+
+// 消费者：最多读出max字节，返回读出的字节数；position不为空时返回这段数据在整个数据流中的起始位置
+size_t gps_ring_read_from(gps_ring_t* ring, char* out, size_t max, size_t* position) {
+    for (;;) {
+        size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+        size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        size_t len = head - tail;
+        if (len > max) {
+            len = max;
+        }
+        if (len == 0) {
+            return 0;
+        }
+
+        size_t start = tail & ring->mask;
+        size_t first = ring->capacity - start;
+        if (first > len) {
+            first = len;
+        }
+        memcpy(out, ring->buffer + start, first);
+        memcpy(out + first, ring->buffer, len - first);
+
+        // 复制期间生产者可能丢弃了这段数据，CAS失败时重新读取
+        if (atomic_compare_exchange_strong_explicit(&ring->tail, &tail, tail + len,
+                                                    memory_order_acq_rel, memory_order_acquire)) {
+            atomic_fetch_add_explicit(&ring->read_bytes, len, memory_order_relaxed);
+            if (position != NULL) {
+                *position = tail;
+            }
+            return len;
+        }
+    }
+}
+
+size_t gps_ring_read(gps_ring_t* ring, char* out, size_t max) {
+    return gps_ring_read_from(ring, out, max, NULL);
+}
+
+// 生产者：当前写位置，即到目前为止写入数据流的总长度
+size_t gps_ring_head(const gps_ring_t* ring) {
+    return atomic_load_explicit(&ring->head, memory_order_relaxed);
+}
+
+size_t gps_ring_size(const gps_ring_t* ring) {
+    size_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    size_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+    return head - tail;
+}
+
+void gps_ring_get_stats(const gps_ring_t* ring, gps_ring_stats_t* stats) {
+    stats->written_bytes = atomic_load_explicit(&ring->written_bytes, memory_order_relaxed);
+    stats->read_bytes = atomic_load_explicit(&ring->read_bytes, memory_order_relaxed);
+    stats->dropped_writes = atomic_load_explicit(&ring->dropped_writes, memory_order_relaxed);
+    stats->dropped_bytes = atomic_load_explicit(&ring->dropped_bytes, memory_order_relaxed);
+    stats->overwritten_bytes = atomic_load_explicit(&ring->overwritten_bytes, memory_order_relaxed);
+}
@@ -0,0 +1,78 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_RINGBUFFER_H
+#define NMEA0183_RINGBUFFER_H
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 单生产者/单消费者无锁字节环形缓冲区
+// 生产者（读串口的线程或中断）只调用 reserve/put/commit/write/free_spans，消费者（解析线程）只调用 read
+// head只由生产者修改，tail由消费者修改；丢弃最旧数据模式下生产者也会用CAS推进tail
+
+#ifndef GPS_CACHE_LINE
+#define GPS_CACHE_LINE 64
+#endif
+
+// 等待空间时的让出方式，可以按平台替换成 sched_yield() 或RTOS的延时
+#ifndef GPS_RING_RELAX
+#define GPS_RING_RELAX() ((void) 0)
+#endif
+
+#define GPS_RING_DROP_NEWEST 0  // 空间不足时丢弃新写入的数据
+#define GPS_RING_DROP_OLDEST 1  // 空间不足时丢弃最旧的数据
+#define GPS_RING_BLOCK 2        // 空间不足时等待消费者读出
+
+// 统计计数（只增不减）
+typedef struct {
+    uint64_t written_bytes;    // 成功写入的字节数
+    uint64_t read_bytes;       // 消费者读出的字节数
+    uint64_t dropped_writes;   // 因空间不足被丢弃的写入次数
+    uint64_t dropped_bytes;    // 因空间不足被丢弃的新数据字节数
+    uint64_t overwritten_bytes;// 丢弃最旧数据模式下被覆盖的旧数据字节数
+} gps_ring_stats_t;
+
+typedef struct {
+    _Alignas(GPS_CACHE_LINE) atomic_size_t head; // 生产者写位置（单调递增）
+    _Alignas(GPS_CACHE_LINE) atomic_size_t tail; // 消费者读位置（单调递增）
+
+    _Alignas(GPS_CACHE_LINE) char* buffer;
+    size_t capacity;           // 容量，必须是2的幂
+    size_t mask;
+    atomic_int policy;
+
+    atomic_uint_fast64_t written_bytes;
+    atomic_uint_fast64_t read_bytes;
+    atomic_uint_fast64_t dropped_writes;
+    atomic_uint_fast64_t dropped_bytes;
+    atomic_uint_fast64_t overwritten_bytes;
+} gps_ring_t;
+
+// 一段连续的空闲空间
+typedef struct {
+    char* data;
+    size_t len;
+} gps_ring_span_t;
+
+// 静态初始化，storage的大小必须是2的幂
+#define GPS_RING_INITIALIZER(storage, size, overflow_policy) \
+    {.buffer = (storage), .capacity = (size), .mask = (size) - 1, .policy = (overflow_policy)}
+
+int gps_ring_init(gps_ring_t* ring, char* storage, size_t capacity, int policy);
+void gps_ring_set_policy(gps_ring_t* ring, int policy);
+
+int gps_ring_reserve(gps_ring_t* ring, size_t len);
+void gps_ring_put(gps_ring_t* ring, size_t offset, const char* data, size_t len);
+void gps_ring_commit(gps_ring_t* ring, size_t len);
+size_t gps_ring_write(gps_ring_t* ring, const char* data, size_t len);
+size_t gps_ring_free_spans(gps_ring_t* ring, gps_ring_span_t spans[2]);
+size_t gps_ring_head(const gps_ring_t* ring);
+
+size_t gps_ring_read(gps_ring_t* ring, char* out, size_t max);
+size_t gps_ring_read_from(gps_ring_t* ring, char* out, size_t max, size_t* position);
+size_t gps_ring_size(const gps_ring_t* ring);
+void gps_ring_get_stats(const gps_ring_t* ring, gps_ring_stats_t* stats);
+
+#endif // NMEA0183_RINGBUFFER_H
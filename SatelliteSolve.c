@@ -16,6 +16,21 @@ char* strtok_my(char *rest,char* c,char **dest) {
     return 0;
 }
 
+// 找校验和分隔符'*'，最多找NMEA_MAX_SENTENCE个字符
+// 没有'*'返回NULL；超长时返回查找的终点，调用方按长度超限(-4)处理
+const char* nmea_find_checksum(const char* sentence) {
+    for (int i = 0; i <= NMEA_MAX_SENTENCE; i++) {
+        if (sentence[i] == '*') {
+            return sentence + i;
+        }
+        if (sentence[i] == '\0') {
+            return NULL;
+        }
+    }
+    return sentence + NMEA_MAX_SENTENCE + 1;
+}
+
+#if GPS_ENABLE_GSA
 // 解析GPGSA语句
 int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
     if (sentence == NULL || gsa == NULL) {
@@ -28,13 +43,13 @@ int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -72,6 +87,7 @@ int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
     char pdop_str[16] = {0};
     char hdop_str[16] = {0};
     char vdop_str[16] = {0};
+    char system_str[2] = {0};
 
     while ((token = strtok_my(rest, ",", &rest))) {
         field_count++;
@@ -112,6 +128,10 @@ int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
                 break;
         }
     }
+    // strtok_my不返回最后一个字段，VDOP后面剩下的就是系统ID（NMEA 4.10+）
+    if (field_count == 18) {
+        strncpy(system_str, rest, sizeof(system_str)-1);
+    }
 
     // 解析模式1
     if (strlen(mode1_str) > 0) {
@@ -123,7 +143,7 @@ int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
 
     // 解析模式2
     if (strlen(mode2_str) > 0) {
-        int mode2 = atoi(mode2_str);
+        int mode2 = GPS_PARSE_INT(mode2_str);
         if (mode2 >= 1 && mode2 <= 3) {
             gsa->mode2 = mode2;
             gsa->has_mode2 = 1;
@@ -133,7 +153,7 @@ int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
     // 解析卫星PRN列表
     for (int i = 0; i < 12; i++) {
         if (strlen(satellite_strs[i]) > 0) {
-            int prn = atoi(satellite_strs[i]);
+            int prn = GPS_PARSE_INT(satellite_strs[i]);
             if (prn > 0) {
                 gsa->satellites[gsa->satellite_count] = prn;
                 gsa->satellite_count++;
@@ -143,33 +163,44 @@ int parse_gpgsa(const char* sentence, gps_gsa_t* gsa) {
 
     // 解析精度因子
     if (strlen(pdop_str) > 0) {
-        double pdop = atof(pdop_str);
-        if (pdop >= 0.0 && pdop <= 99.9) {
+        gps_dop_t pdop = GPS_PARSE(pdop_str, DOP);
+        if (pdop >= 0 && pdop <= GPS_CONST(99.9, DOP)) {
             gsa->pdop = pdop;
             gsa->has_pdop = 1;
         }
     }
 
     if (strlen(hdop_str) > 0) {
-        double hdop = atof(hdop_str);
-        if (hdop >= 0.0 && hdop <= 99.9) {
+        gps_dop_t hdop = GPS_PARSE(hdop_str, DOP);
+        if (hdop >= 0 && hdop <= GPS_CONST(99.9, DOP)) {
             gsa->hdop = hdop;
             gsa->has_hdop = 1;
         }
     }
 
     if (strlen(vdop_str) > 0) {
-        double vdop = atof(vdop_str);
-        if (vdop >= 0.0 && vdop <= 99.9) {
+        gps_dop_t vdop = GPS_PARSE(vdop_str, DOP);
+        if (vdop >= 0 && vdop <= GPS_CONST(99.9, DOP)) {
             gsa->vdop = vdop;
             gsa->has_vdop = 1;
         }
     }
 
+    // GN多系统输出时每个系统一条GSA，靠系统ID字段区分，换成和单系统talker一样的字母
+    switch (system_str[0]) {
+        case '1': gsa->system_id = 'P'; break;
+        case '2': gsa->system_id = 'L'; break;
+        case '3': gsa->system_id = 'A'; break;
+        case '4': gsa->system_id = 'B'; break;
+        case '5': gsa->system_id = 'Q'; break;
+        default: break;
+    }
     gsa->has_system_id = 1;
 
     return 0;
 }
+#endif
+#if GPS_ENABLE_GSA && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gpgsa_info(const gps_gsa_t* gsa) {
     printf("=== GPS GSA Data ===\n");
@@ -237,7 +268,9 @@ void print_gpgsa_info(const gps_gsa_t* gsa) {
 
     printf("====================\n");
 }
+#endif
 
+#if GPS_ENABLE_GSV
 // 解析单个GPGSV语句
 int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
     if (sentence == NULL || gsv == NULL) {
@@ -250,13 +283,13 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
     }
 
     // 查找校验和分隔符
-    const char* checksum_start = strchr(sentence, '*');
+    const char* checksum_start = nmea_find_checksum(sentence);
     if (checksum_start == NULL) {
         return -3;
     }
 
     // 复制语句用于解析（不包含校验和部分）
-    char buffer[256];
+    char buffer[NMEA_MAX_SENTENCE];
     int len = checksum_start - sentence - 1; // 从$后到*前的内容
     if (len >= sizeof(buffer)) {
         return -4;
@@ -333,7 +366,7 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
 
     // 解析语句信息
     if (strlen(total_msg_str) > 0) {
-        int total_msgs = atoi(total_msg_str);
+        int total_msgs = GPS_PARSE_INT(total_msg_str);
         if (total_msgs >= 1 && total_msgs <= 9) {
             gsv->total_messages = total_msgs;
             gsv->has_total_messages = 1;
@@ -341,7 +374,7 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
     }
 
     if (strlen(msg_num_str) > 0) {
-        int msg_num = atoi(msg_num_str);
+        int msg_num = GPS_PARSE_INT(msg_num_str);
         if (msg_num >= 1 && msg_num <= 9) {
             gsv->message_number = msg_num;
             gsv->has_message_number = 1;
@@ -349,7 +382,7 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
     }
 
     if (strlen(total_sat_str) > 0) {
-        int total_sats = atoi(total_sat_str);
+        int total_sats = GPS_PARSE_INT(total_sat_str);
         if (total_sats >= 0 && total_sats <= 99) {
             gsv->total_satellites = total_sats;
             gsv->has_total_satellites = 1;
@@ -362,14 +395,14 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
     for (int i = 0; i < 4; i++) {
         // 检查是否有PRN数据（第一个数据项）
         if (strlen(sat_data[i][0]) > 0) {
-            int prn = atoi(sat_data[i][0]);
+            int prn = GPS_PARSE_INT(sat_data[i][0]);
             if (prn > 0) {
                 gsv->satellites[gsv->satellite_count].prn = prn;
                 gsv->satellites[gsv->satellite_count].is_valid = 1;
 
                 // 解析仰角
                 if (strlen(sat_data[i][1]) > 0) {
-                    int elevation = atoi(sat_data[i][1]);
+                    int elevation = GPS_PARSE_INT(sat_data[i][1]);
                     if (elevation >= 0 && elevation <= 90) {
                         gsv->satellites[gsv->satellite_count].elevation = elevation;
                     }
@@ -377,7 +410,7 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
 
                 // 解析方位角
                 if (strlen(sat_data[i][2]) > 0) {
-                    int azimuth = atoi(sat_data[i][2]);
+                    int azimuth = GPS_PARSE_INT(sat_data[i][2]);
                     if (azimuth >= 0 && azimuth <= 359) {
                         gsv->satellites[gsv->satellite_count].azimuth = azimuth;
                     }
@@ -385,7 +418,7 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
 
                 // 解析信噪比
                 if (strlen(sat_data[i][3]) > 0) {
-                    int snr = atoi(sat_data[i][3]);
+                    int snr = GPS_PARSE_INT(sat_data[i][3]);
                     if (snr >= 0 && snr <= 99) {
                         gsv->satellites[gsv->satellite_count].snr = snr;
                     }
@@ -398,7 +431,9 @@ int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv) {
 
     return 0;
 }
+#endif
 
+#if GPS_ENABLE_GSV && GPS_ENABLE_PRINT
 // 打印解析结果的辅助函数
 void print_gpgsv_single_info(const gps_gsv_t* gsv) {
     printf("=== GPS GSV Data (Single Message) ===\n");
@@ -463,4 +498,5 @@ void print_gpgsv_single_info(const gps_gsv_t* gsv) {
     printf("  Satellite Data: %s\n", gsv->satellite_count > 0 ? "Available" : "Not Available");
 
     printf("=====================================\n");
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #ifndef NMEA0183_SATELLITESOLVE_H
 #define NMEA0183_SATELLITESOLVE_H
+#include "GPSConfig.h"
+#include "FixedPoint.h"
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
@@ -21,12 +23,13 @@ typedef struct {
     int satellite_count;       // 实际使用的卫星数量
 
     // 精度因子
-    double pdop;               // 位置精度因子
-    double hdop;               // 水平精度因子
-    double vdop;               // 垂直精度因子
+    gps_dop_t pdop;            // 位置精度因子
+    gps_dop_t hdop;            // 水平精度因子
+    gps_dop_t vdop;            // 垂直精度因子
 
     // 系统标识（NMEA 4.10+）
-    char system_id;            // 系统标识：'G'=GPS，'P'=GPS/PPS，'L'=GLONASS，'A'=Galileo，'B'=BeiDou，'N'=GNSS
+    char system_id;            // 系统标识：'G'=GPS，'P'=GPS/PPS，'L'=GLONASS，'A'=Galileo，'B'=BeiDou，'Q'=QZSS，'N'=GNSS
+                               // GN语句带系统ID字段时取该字段对应的系统，不带时为'N'
 
     // 数据有效性标志
     int has_mode1;
@@ -75,9 +78,18 @@ typedef struct {
     gps_gsv_t gsv[MAX_KIND_OF_SATELLITE][EACH_KIND_OF_SATELLITE];//观测到的
 }gps_satellites;
 char* strtok_my(char *rest,char* c,char **dest);
+const char* nmea_find_checksum(const char* sentence);
+#if GPS_ENABLE_GSA
 int parse_gpgsa(const char* sentence, gps_gsa_t* gsa);
+#if GPS_ENABLE_PRINT
 void print_gpgsa_info(const gps_gsa_t* gsa);
+#endif
+#endif
+#if GPS_ENABLE_GSV
 int parse_gpgsv_single(const char* sentence, gps_gsv_t* gsv);
+#if GPS_ENABLE_PRINT
 void print_gpgsv_single_info(const gps_gsv_t* gsv);
+#endif
+#endif
 
 #endif // NMEA0183_SATELLITESOLVE_H
@@ -0,0 +1,222 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "SerialReader.h"
+
+#if GPS_ENABLE_SERIAL
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <unistd.h>
+#include "GPSSolve.h"
+
+static speed_t serial_speed(uint32_t baud) {
+    switch (baud) {
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        default: return 0;
+    }
+}
+
+// 原始模式，8N1，不做回显和行处理；VMIN=0/VTIME=0，配合非阻塞读
+static int serial_configure(int fd, speed_t speed) {
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    return tcsetattr(fd, TCSANOW, &tio);
+}
+
+int gps_serial_reader_init(gps_serial_reader_t* reader) {
+    if (reader == NULL) {
+        return -1;
+    }
+    reader->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    reader->port_count = 0;
+    reader->open_count = 0;
+    for (int i = 0; i < GPS_SERIAL_MAX_PORTS; i++) {
+        reader->ports[i].fd = -1;
+    }
+    return reader->epoll_fd < 0 ? -2 : 0;
+}
+
+// 登记一个已经打开的fd（管道、socket、已配置好的tty都可以），会被设成非阻塞，之后由reader负责关闭
+// 返回：端口号，-1=空指针，-2=epoll_ctl失败，-4=端口数已满
+int gps_serial_add_fd(gps_serial_reader_t* reader, int fd, gps_ring_t* ring, gps_serial_data_fn on_data, void* user) {
+    if (reader == NULL || fd < 0) {
+        return -1;
+    }
+    int port = 0;
+    while (port < reader->port_count && reader->ports[port].fd >= 0) {
+        port++;
+    }
+    if (port >= GPS_SERIAL_MAX_PORTS) {
+        return -4;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    struct epoll_event event = {.events = EPOLLIN, .data.u32 = (uint32_t) port};
+    if (epoll_ctl(reader->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+        return -2;
+    }
+
+    gps_serial_port_t* p = &reader->ports[port];
+    p->fd = fd;
+    p->ring = ring;
+    p->on_data = on_data;
+    p->user = user;
+    p->bytes = 0;
+    p->reads = 0;
+    p->zero_copy_bytes = 0;
+    p->error = 0;
+    if (port == reader->port_count) {
+        reader->port_count++;
+    }
+    reader->open_count++;
+    return port;
+}
+
+// 打开并配置一个tty
+// 返回：端口号，-1=空指针，-2=打开或配置失败，-3=不支持的波特率，-4=端口数已满
+int gps_serial_open(gps_serial_reader_t* reader, const char* path, uint32_t baud, gps_ring_t* ring,
+                    gps_serial_data_fn on_data, void* user) {
+    if (reader == NULL || path == NULL) {
+        return -1;
+    }
+    speed_t speed = serial_speed(baud);
+    if (speed == 0) {
+        return -3;
+    }
+    int fd = open(path, O_RDONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return -2;
+    }
+    if (isatty(fd) && serial_configure(fd, speed) != 0) {
+        close(fd);
+        return -2;
+    }
+    int port = gps_serial_add_fd(reader, fd, ring, on_data, user);
+    if (port < 0) {
+        close(fd);
+    }
+    return port;
+}
+
+void gps_serial_close_port(gps_serial_reader_t* reader, int port) {
+    if (reader == NULL || port < 0 || port >= reader->port_count || reader->ports[port].fd < 0) {
+        return;
+    }
+    epoll_ctl(reader->epoll_fd, EPOLL_CTL_DEL, reader->ports[port].fd, NULL);
+    close(reader->ports[port].fd);
+    reader->ports[port].fd = -1;
+    reader->open_count--;
+}
+
+// 读一次：有空闲空间就readv直接读进环形缓冲区，否则读进临时缓冲区按溢出策略写入
+// 返回读到的字节数，0表示暂时没有数据，-1表示端口已关闭
+static int serial_read_port(gps_serial_reader_t* reader, int port) {
+    gps_serial_port_t* p = &reader->ports[port];
+    gps_ring_t* ring = p->ring != NULL ? p->ring : get_input_ring();
+    gps_ring_span_t spans[2];
+    ssize_t n;
+    int zero_copy = gps_ring_free_spans(ring, spans) > 0;
+    char scratch[GPS_SERIAL_SCRATCH];
+    if (zero_copy) {
+        struct iovec iov[2] = {{spans[0].data, spans[0].len}, {spans[1].data, spans[1].len}};
+        n = readv(p->fd, iov, spans[1].len > 0 ? 2 : 1);
+    } else {
+        n = read(p->fd, scratch, sizeof(scratch));
+    }
+    p->reads++;
+
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EINTR) {
+            return 0;
+        }
+        p->error = errno; // 伪终端对端关闭时是EIO
+        gps_serial_close_port(reader, port);
+        return -1;
+    }
+    if (n == 0) {
+        gps_serial_close_port(reader, port);
+        return -1;
+    }
+
+    uint32_t committed;
+    if (zero_copy) {
+        gps_ring_commit(ring, (size_t) n);
+        p->zero_copy_bytes += (uint64_t) n;
+        committed = (uint32_t) n;
+    } else {
+        committed = (uint32_t) gps_ring_write(ring, scratch, (size_t) n);
+    }
+    p->bytes += (uint64_t) n;
+    if (committed > 0) {
+        if (p->ring == NULL) {
+            mark_input_arrival();
+        }
+        if (p->on_data != NULL) {
+            p->on_data(port, committed, p->user);
+        }
+    }
+    return (int) n;
+}
+
+// 等待并处理一批就绪端口，每个端口每批只读一次，避免一个高速端口饿死其它端口
+// 返回：读到的总字节数，-1=空指针，-2=epoll_wait失败，-3=没有打开的端口
+int gps_serial_poll(gps_serial_reader_t* reader, int timeout_ms) {
+    if (reader == NULL) {
+        return -1;
+    }
+    if (reader->open_count == 0) {
+        return -3;
+    }
+    struct epoll_event events[GPS_SERIAL_EVENTS];
+    int count = epoll_wait(reader->epoll_fd, events, GPS_SERIAL_EVENTS, timeout_ms);
+    if (count < 0) {
+        return errno == EINTR ? 0 : -2;
+    }
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        int port = (int) events[i].data.u32;
+        if (reader->ports[port].fd < 0) {
+            continue;
+        }
+        int n = serial_read_port(reader, port);
+        if (n > 0) {
+            total += n;
+        }
+    }
+    return total;
+}
+
+void gps_serial_reader_close(gps_serial_reader_t* reader) {
+    if (reader == NULL) {
+        return;
+    }
+    for (int i = 0; i < reader->port_count; i++) {
+        gps_serial_close_port(reader, i);
+    }
+    if (reader->epoll_fd >= 0) {
+        close(reader->epoll_fd);
+        reader->epoll_fd = -1;
+    }
+}
+#endif
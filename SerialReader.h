@@ -0,0 +1,60 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_SERIALREADER_H
+#define NMEA0183_SERIALREADER_H
+#include <stdint.h>
+#include "RingBuffer.h"
+
+// 基于epoll的非阻塞串口读取：一个线程服务多个tty（也可以是伪终端），
+// 数据用readv直接读进目标环形缓冲区的空闲段，不经过中间缓冲区
+// 每个端口对应一个环形缓冲区；ring传NULL表示写进GPSSolve的输入缓冲区（解析器只有一个实例，只能有一个端口这样用）
+// 环形缓冲区满时退回到读进临时缓冲区再gps_ring_write，按缓冲区的溢出策略丢弃/覆盖/等待，不会让epoll空转
+
+#ifndef GPS_ENABLE_SERIAL
+#ifdef __linux__
+#define GPS_ENABLE_SERIAL 1
+#else
+#define GPS_ENABLE_SERIAL 0
+#endif
+#endif
+
+#ifndef GPS_SERIAL_MAX_PORTS
+#define GPS_SERIAL_MAX_PORTS 64
+#endif
+#define GPS_SERIAL_EVENTS 16       // 每次epoll_wait最多处理的事件数
+#define GPS_SERIAL_SCRATCH 512     // 环形缓冲区满时的临时缓冲区
+
+// 端口收到数据后的回调（在gps_serial_poll所在线程），len是本次提交到ring的字节数
+typedef void (*gps_serial_data_fn)(int port, uint32_t len, void* user);
+
+typedef struct {
+    int fd;                    // -1表示空闲或已关闭
+    gps_ring_t* ring;
+    gps_serial_data_fn on_data;
+    void* user;
+    uint64_t bytes;            // 读到的字节数
+    uint64_t reads;            // read调用次数
+    uint64_t zero_copy_bytes;  // 直接读进环形缓冲区的字节数
+    int error;                 // 关闭原因：0=正常，其它是errno
+} gps_serial_port_t;
+
+typedef struct {
+    int epoll_fd;
+    int port_count;            // 用过的端口槽位数
+    int open_count;            // 仍然打开的端口数
+    gps_serial_port_t ports[GPS_SERIAL_MAX_PORTS];
+} gps_serial_reader_t;
+
+#if GPS_ENABLE_SERIAL
+int gps_serial_reader_init(gps_serial_reader_t* reader);
+int gps_serial_open(gps_serial_reader_t* reader, const char* path, uint32_t baud, gps_ring_t* ring,
+                    gps_serial_data_fn on_data, void* user);
+int gps_serial_add_fd(gps_serial_reader_t* reader, int fd, gps_ring_t* ring, gps_serial_data_fn on_data, void* user);
+int gps_serial_poll(gps_serial_reader_t* reader, int timeout_ms);
+void gps_serial_close_port(gps_serial_reader_t* reader, int port);
+void gps_serial_reader_close(gps_serial_reader_t* reader);
+#endif
+
+#endif // NMEA0183_SERIALREADER_H
@@ -0,0 +1,153 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "ShmPublish.h"
+
+#if GPS_ENABLE_SHM
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+_Static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared-memory sequence counter must be lock-free");
+
+static void shm_set_name(gps_shm_t* shm, const char* name) {
+    strncpy(shm->name, name != NULL ? name : GPS_SHM_DEFAULT_NAME, sizeof(shm->name) - 1);
+    shm->name[sizeof(shm->name) - 1] = '\0';
+}
+
+// 创建（或接管已有的）共享内存段并初始化段头，写入端只能有一个
+// 返回：0=成功，-1=空指针，-2=shm_open/ftruncate失败，-3=mmap失败
+int gps_shm_publisher_open(gps_shm_t* shm, const char* name) {
+    if (shm == NULL) {
+        return -1;
+    }
+    shm_set_name(shm, name);
+    shm->segment = NULL;
+
+    int fd = shm_open(shm->name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        return -2;
+    }
+    if (ftruncate(fd, sizeof(gps_shm_segment_t)) != 0) {
+        close(fd);
+        return -2;
+    }
+    void* map = mmap(NULL, sizeof(gps_shm_segment_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -3;
+    }
+
+    gps_shm_segment_t* segment = map;
+    // 先让序号变成奇数，读取端在段头写好之前不会读
+    atomic_store_explicit(&segment->sequence, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    segment->magic = GPS_SHM_MAGIC;
+    segment->version = GPS_SHM_VERSION;
+    segment->layout = GPS_SHM_LAYOUT;
+    segment->data_size = sizeof(gps_data_t);
+    segment->epochs = 0;
+    segment->publish_ns = 0;
+    memset(&segment->data, 0, sizeof(gps_data_t));
+    atomic_store_explicit(&segment->sequence, 2, memory_order_release);
+    shm->segment = segment;
+    return 0;
+}
+
+// 发布一个历元
+int gps_shm_publish(gps_shm_t* shm, const gps_data_t* data, uint64_t publish_ns) {
+    if (shm == NULL || shm->segment == NULL || data == NULL) {
+        return -1;
+    }
+    gps_shm_segment_t* segment = shm->segment;
+    unsigned sequence = atomic_load_explicit(&segment->sequence, memory_order_relaxed);
+    atomic_store_explicit(&segment->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    segment->data = *data;
+    segment->epochs++;
+    segment->publish_ns = publish_ns;
+    atomic_store_explicit(&segment->sequence, sequence + 2, memory_order_release);
+    return 0;
+}
+
+// 只读映射已有的段并检查布局
+// 返回：0=成功，-1=空指针，-2=段不存在，-3=mmap失败，-4=段头不对（版本或编译配置不一致，或写入端还没初始化完）
+int gps_shm_reader_open(gps_shm_t* shm, const char* name) {
+    if (shm == NULL) {
+        return -1;
+    }
+    shm_set_name(shm, name);
+    shm->segment = NULL;
+
+    int fd = shm_open(shm->name, O_RDONLY, 0);
+    if (fd < 0) {
+        return -2;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(gps_shm_segment_t)) {
+        close(fd);
+        return -4;
+    }
+    void* map = mmap(NULL, sizeof(gps_shm_segment_t), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -3;
+    }
+
+    gps_shm_segment_t* segment = map;
+    if (segment->magic != GPS_SHM_MAGIC || segment->version != GPS_SHM_VERSION ||
+        segment->layout != GPS_SHM_LAYOUT || segment->data_size != sizeof(gps_data_t)) {
+        munmap(map, sizeof(gps_shm_segment_t));
+        return -4;
+    }
+    shm->segment = segment;
+    return 0;
+}
+
+// 读取最新历元的一致快照，epochs/publish_ns可以为NULL
+// 返回：0=成功，-1=空指针，-3=还没有发布过历元，-4=一直被写入打断
+int gps_shm_read(const gps_shm_t* shm, gps_data_t* data, uint64_t* epochs, uint64_t* publish_ns) {
+    if (shm == NULL || shm->segment == NULL || data == NULL) {
+        return -1;
+    }
+    const gps_shm_segment_t* segment = shm->segment;
+    for (int attempt = 0; attempt < GPS_SHM_MAX_RETRY; attempt++) {
+        unsigned before = atomic_load_explicit((atomic_uint*) &segment->sequence, memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        uint64_t count = segment->epochs;
+        uint64_t ns = segment->publish_ns;
+        *data = segment->data;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit((atomic_uint*) &segment->sequence, memory_order_relaxed) != before) {
+            continue;
+        }
+        if (count == 0) {
+            return -3;
+        }
+        if (epochs != NULL) {
+            *epochs = count;
+        }
+        if (publish_ns != NULL) {
+            *publish_ns = ns;
+        }
+        return 0;
+    }
+    return -4;
+}
+
+// 解除映射；写入端退出时可以顺便删除段
+void gps_shm_close(gps_shm_t* shm, int unlink_segment) {
+    if (shm == NULL || shm->segment == NULL) {
+        return;
+    }
+    munmap(shm->segment, sizeof(gps_shm_segment_t));
+    shm->segment = NULL;
+    if (unlink_segment) {
+        shm_unlink(shm->name);
+    }
+}
+#endif
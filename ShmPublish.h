@@ -0,0 +1,59 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_SHMPUBLISH_H
+#define NMEA0183_SHMPUBLISH_H
+#include <stdatomic.h>
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+
+// 把每个历元发布到POSIX共享内存，本机任意多个进程直接映射读取，不经过串口转发或socket中继
+// 单写多读的顺序锁：写入端写前把序号改成奇数、写完改成下一个偶数；读取端复制一份，
+// 前后两次读到同一个偶数序号才算一致，否则重试。读取不需要系统调用
+// 段头带魔数、版本和布局指纹（gps_data_t大小、整数模式、打开的语句类型），编译配置不同的进程不会读错
+
+#ifndef GPS_ENABLE_SHM
+#ifdef __linux__
+#define GPS_ENABLE_SHM 1
+#else
+#define GPS_ENABLE_SHM 0
+#endif
+#endif
+
+#define GPS_SHM_DEFAULT_NAME "/nmea0183_fix"
+#define GPS_SHM_MAGIC 0x4E4D4541u  // "NMEA"
+#define GPS_SHM_VERSION 1
+#define GPS_SHM_MAX_RETRY 64       // 读取时被写入打断的最大重试次数
+
+// 影响gps_data_t布局的编译选项
+#define GPS_SHM_LAYOUT ((uint32_t) (GPS_INTEGER_ONLY << 0 | GPS_ENABLE_GGA << 1 | GPS_ENABLE_GLL << 2 | \
+                                    GPS_ENABLE_SATELLITES << 3 | GPS_ENABLE_RMC << 4 | GPS_ENABLE_VTG << 5 | \
+                                    GPS_ENABLE_ZDA << 6))
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t layout;           // GPS_SHM_LAYOUT
+    uint32_t data_size;        // sizeof(gps_data_t)
+    atomic_uint sequence;      // 奇数表示正在写
+    uint32_t reserved;
+    uint64_t epochs;           // 已发布的历元数
+    uint64_t publish_ns;       // 发布时刻（CLOCK_MONOTONIC纳秒，本机进程间可比较）
+    gps_data_t data;
+} gps_shm_segment_t;
+
+typedef struct {
+    gps_shm_segment_t* segment;
+    char name[64];
+} gps_shm_t;
+
+#if GPS_ENABLE_SHM
+int gps_shm_publisher_open(gps_shm_t* shm, const char* name);
+int gps_shm_publish(gps_shm_t* shm, const gps_data_t* data, uint64_t publish_ns);
+int gps_shm_reader_open(gps_shm_t* shm, const char* name);
+int gps_shm_read(const gps_shm_t* shm, gps_data_t* data, uint64_t* epochs, uint64_t* publish_ns);
+void gps_shm_close(gps_shm_t* shm, int unlink_segment);
+#endif
+
+#endif // NMEA0183_SHMPUBLISH_H
@@ -0,0 +1,185 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "StreamDemux.h"
+#include "UbxSolve.h"
+
+// CRC-24Q（多项式0x1864CFB），RTCM3和SBAS用的校验
+static const uint32_t crc24q_table[256] = {
+        0x000000, 0x864CFB, 0x8AD50D, 0x0C99F6, 0x93E6E1, 0x15AA1A, 0x1933EC, 0x9F7F17,
+        0xA18139, 0x27CDC2, 0x2B5434, 0xAD18CF, 0x3267D8, 0xB42B23, 0xB8B2D5, 0x3EFE2E,
+        0xC54E89, 0x430272, 0x4F9B84, 0xC9D77F, 0x56A868, 0xD0E493, 0xDC7D65, 0x5A319E,
+        0x64CFB0, 0xE2834B, 0xEE1ABD, 0x685646, 0xF72951, 0x7165AA, 0x7DFC5C, 0xFBB0A7,
+        0x0CD1E9, 0x8A9D12, 0x8604E4, 0x00481F, 0x9F3708, 0x197BF3, 0x15E205, 0x93AEFE,
+        0xAD50D0, 0x2B1C2B, 0x2785DD, 0xA1C926, 0x3EB631, 0xB8FACA, 0xB4633C, 0x322FC7,
+        0xC99F60, 0x4FD39B, 0x434A6D, 0xC50696, 0x5A7981, 0xDC357A, 0xD0AC8C, 0x56E077,
+        0x681E59, 0xEE52A2, 0xE2CB54, 0x6487AF, 0xFBF8B8, 0x7DB443, 0x712DB5, 0xF7614E,
+        0x19A3D2, 0x9FEF29, 0x9376DF, 0x153A24, 0x8A4533, 0x0C09C8, 0x00903E, 0x86DCC5,
+        0xB822EB, 0x3E6E10, 0x32F7E6, 0xB4BB1D, 0x2BC40A, 0xAD88F1, 0xA11107, 0x275DFC,
+        0xDCED5B, 0x5AA1A0, 0x563856, 0xD074AD, 0x4F0BBA, 0xC94741, 0xC5DEB7, 0x43924C,
+        0x7D6C62, 0xFB2099, 0xF7B96F, 0x71F594, 0xEE8A83, 0x68C678, 0x645F8E, 0xE21375,
+        0x15723B, 0x933EC0, 0x9FA736, 0x19EBCD, 0x8694DA, 0x00D821, 0x0C41D7, 0x8A0D2C,
+        0xB4F302, 0x32BFF9, 0x3E260F, 0xB86AF4, 0x2715E3, 0xA15918, 0xADC0EE, 0x2B8C15,
+        0xD03CB2, 0x567049, 0x5AE9BF, 0xDCA544, 0x43DA53, 0xC596A8, 0xC90F5E, 0x4F43A5,
+        0x71BD8B, 0xF7F170, 0xFB6886, 0x7D247D, 0xE25B6A, 0x641791, 0x688E67, 0xEEC29C,
+        0x3347A4, 0xB50B5F, 0xB992A9, 0x3FDE52, 0xA0A145, 0x26EDBE, 0x2A7448, 0xAC38B3,
+        0x92C69D, 0x148A66, 0x181390, 0x9E5F6B, 0x01207C, 0x876C87, 0x8BF571, 0x0DB98A,
+        0xF6092D, 0x7045D6, 0x7CDC20, 0xFA90DB, 0x65EFCC, 0xE3A337, 0xEF3AC1, 0x69763A,
+        0x578814, 0xD1C4EF, 0xDD5D19, 0x5B11E2, 0xC46EF5, 0x42220E, 0x4EBBF8, 0xC8F703,
+        0x3F964D, 0xB9DAB6, 0xB54340, 0x330FBB, 0xAC70AC, 0x2A3C57, 0x26A5A1, 0xA0E95A,
+        0x9E1774, 0x185B8F, 0x14C279, 0x928E82, 0x0DF195, 0x8BBD6E, 0x872498, 0x016863,
+        0xFAD8C4, 0x7C943F, 0x700DC9, 0xF64132, 0x693E25, 0xEF72DE, 0xE3EB28, 0x65A7D3,
+        0x5B59FD, 0xDD1506, 0xD18CF0, 0x57C00B, 0xC8BF1C, 0x4EF3E7, 0x426A11, 0xC426EA,
+        0x2AE476, 0xACA88D, 0xA0317B, 0x267D80, 0xB90297, 0x3F4E6C, 0x33D79A, 0xB59B61,
+        0x8B654F, 0x0D29B4, 0x01B042, 0x87FCB9, 0x1883AE, 0x9ECF55, 0x9256A3, 0x141A58,
+        0xEFAAFF, 0x69E604, 0x657FF2, 0xE33309, 0x7C4C1E, 0xFA00E5, 0xF69913, 0x70D5E8,
+        0x4E2BC6, 0xC8673D, 0xC4FECB, 0x42B230, 0xDDCD27, 0x5B81DC, 0x57182A, 0xD154D1,
+        0x26359F, 0xA07964, 0xACE092, 0x2AAC69, 0xB5D37E, 0x339F85, 0x3F0673, 0xB94A88,
+        0x87B4A6, 0x01F85D, 0x0D61AB, 0x8B2D50, 0x145247, 0x921EBC, 0x9E874A, 0x18CBB1,
+        0xE37B16, 0x6537ED, 0x69AE1B, 0xEFE2E0, 0x709DF7, 0xF6D10C, 0xFA48FA, 0x7C0401,
+        0x42FA2F, 0xC4B6D4, 0xC82F22, 0x4E63D9, 0xD11CCE, 0x575035, 0x5BC9C3, 0xDD8538,
+};
+
+uint32_t rtcm3_crc24q(const uint8_t* data, uint32_t len) {
+    uint32_t crc = 0;
+    for (uint32_t i = 0; i < len; i++) {
+        crc = ((crc << 8) & 0xFFFFFF) ^ crc24q_table[(crc >> 16) ^ data[i]];
+    }
+    return crc;
+}
+
+// 校验一帧RTCM3：len是缓冲区里从0xD3开始的可用字节数
+// 返回：0=正确，-1=空指针，-2=帧头不对，-3=帧不完整，-5=CRC错误
+int rtcm3_verify_crc(const uint8_t* frame, uint32_t len) {
+    if (frame == NULL) {
+        return -1;
+    }
+    if (len < RTCM3_HEADER_SIZE) {
+        return -3;
+    }
+    if (frame[0] != RTCM3_PREAMBLE || (frame[1] & 0xFC) != 0) {
+        return -2;
+    }
+    uint32_t payload_len = (uint32_t) (frame[1] & 0x03) << 8 | frame[2];
+    if (len < payload_len + RTCM3_FRAME_OVERHEAD) {
+        return -3;
+    }
+    const uint8_t* crc = frame + RTCM3_HEADER_SIZE + payload_len;
+    uint32_t expected = (uint32_t) crc[0] << 16 | (uint32_t) crc[1] << 8 | crc[2];
+    return rtcm3_crc24q(frame, RTCM3_HEADER_SIZE + payload_len) == expected ? 0 : -5;
+}
+
+#define SCAN_NOT_FRAME (-1)
+
+// 从'$'/'!'开始找行尾；遇到不可打印字符说明这一行被截断了，不算帧
+// '$'/'!'只能出现在语句开头，行中间又遇到一个说明前面是没有行尾的半行（或者线路噪声），
+// 同样不算帧，调用方把这段字节记为跳过，从新的起始符重新分帧，免得把后面完整的语句吞掉
+static int scan_nmea(const uint8_t* p, uint32_t len, gps_frame_t* frame) {
+    for (uint32_t i = 1; i < len; i++) {
+        uint8_t c = p[i];
+        if (c == '$' || c == '!') {
+            return SCAN_NOT_FRAME;
+        }
+        if (c == '\n') {
+            frame->protocol = GPS_PROTOCOL_NMEA;
+            frame->length = i > 1 && p[i - 1] == '\r' ? i - 1 : i;
+            frame->consumed = i + 1;
+            return GPS_DEMUX_FRAME;
+        }
+        if ((c < 0x20 || c > 0x7E) && c != '\r') {
+            return SCAN_NOT_FRAME;
+        }
+    }
+    return GPS_DEMUX_NEED_MORE;
+}
+
+static int scan_ubx(const uint8_t* p, uint32_t len, gps_frame_t* frame) {
+    if (len < 2) {
+        return GPS_DEMUX_NEED_MORE;
+    }
+    if (p[1] != UBX_SYNC_CHAR_2) {
+        return SCAN_NOT_FRAME;
+    }
+    if (len < UBX_HEADER_SIZE) {
+        return GPS_DEMUX_NEED_MORE;
+    }
+    uint32_t payload_len = ubx_u16(p + 4);
+    if (payload_len > UBX_MAX_PAYLOAD) {
+        return SCAN_NOT_FRAME;
+    }
+    if (len < payload_len + UBX_FRAME_OVERHEAD) {
+        return GPS_DEMUX_NEED_MORE;
+    }
+    frame->protocol = GPS_PROTOCOL_UBX;
+    frame->length = payload_len + UBX_FRAME_OVERHEAD;
+    if (ubx_verify_checksum(p, frame->length) != 0) {
+        frame->consumed = 1;
+        return GPS_DEMUX_BAD_CHECKSUM;
+    }
+    frame->consumed = frame->length;
+    return GPS_DEMUX_FRAME;
+}
+
+static int scan_rtcm3(const uint8_t* p, uint32_t len, gps_frame_t* frame) {
+    if (len < RTCM3_HEADER_SIZE) {
+        return GPS_DEMUX_NEED_MORE;
+    }
+    if ((p[1] & 0xFC) != 0) {
+        return SCAN_NOT_FRAME;
+    }
+    uint32_t payload_len = (uint32_t) (p[1] & 0x03) << 8 | p[2];
+    if (len < payload_len + RTCM3_FRAME_OVERHEAD) {
+        return GPS_DEMUX_NEED_MORE;
+    }
+    frame->protocol = GPS_PROTOCOL_RTCM3;
+    frame->length = payload_len + RTCM3_FRAME_OVERHEAD;
+    if (rtcm3_verify_crc(p, frame->length) != 0) {
+        frame->consumed = 1;
+        return GPS_DEMUX_BAD_CHECKSUM;
+    }
+    frame->consumed = frame->length;
+    return GPS_DEMUX_FRAME;
+}
+
+// 从buf里切下一帧，调用方每次前进frame->consumed个字节
+// 返回GPS_DEMUX_*；NEED_MORE时consumed只包含跳过的字节，剩下的半帧要留到下次
+int gps_demux_next(const uint8_t* buf, uint32_t len, gps_frame_t* frame) {
+    uint32_t pos = 0;
+    while (pos < len) {
+        int ret;
+        switch (buf[pos]) {
+            case '$':
+            case '!':
+                ret = scan_nmea(buf + pos, len - pos, frame);
+                break;
+            case UBX_SYNC_CHAR_1:
+                ret = scan_ubx(buf + pos, len - pos, frame);
+                break;
+            case RTCM3_PREAMBLE:
+                ret = scan_rtcm3(buf + pos, len - pos, frame);
+                break;
+            default:
+                pos++;
+                continue;
+        }
+        if (ret == SCAN_NOT_FRAME) {
+            pos++;
+            continue;
+        }
+        frame->data = buf + pos;
+        frame->skipped = pos;
+        if (ret == GPS_DEMUX_NEED_MORE) {
+            frame->length = 0;
+            frame->consumed = pos;
+        } else {
+            frame->consumed += pos;
+        }
+        return ret;
+    }
+    frame->data = buf + len;
+    frame->length = 0;
+    frame->skipped = len;
+    frame->consumed = len;
+    return GPS_DEMUX_NEED_MORE;
+}
@@ -0,0 +1,44 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_STREAMDEMUX_H
+#define NMEA0183_STREAMDEMUX_H
+#include <stdint.h>
+#include <stddef.h>
+
+// 混合协议分帧：串口上NMEA文本、UBX二进制和RTCM3差分帧交错出现时，按各自的同步字和长度一遍切出完整的帧
+//   NMEA   '$'或'!'开头、换行结尾的可打印字符行（异或校验和由nmea_verify_checksum检查）；
+//          行中间再出现'$'/'!'时前面的半行作废，从新的起始符重新开始
+//   UBX    0xB5 0x62 class id 长度(2字节小端) 负载 8位Fletcher校验和
+//   RTCM3  0xD3 6位保留(0) 10位长度 负载 CRC-24Q(3字节大端)
+// 帧不复制，gps_frame_t直接指向输入缓冲区；不属于任何帧的字节算作跳过
+
+#define GPS_PROTOCOL_NMEA 0
+#define GPS_PROTOCOL_UBX 1
+#define GPS_PROTOCOL_RTCM3 2
+#define GPS_PROTOCOL_COUNT 3
+
+#define RTCM3_PREAMBLE 0xD3
+#define RTCM3_HEADER_SIZE 3
+#define RTCM3_FRAME_OVERHEAD 6     // 帧头加3字节CRC
+#define RTCM3_MAX_PAYLOAD 1023
+
+// gps_demux_next的返回值
+#define GPS_DEMUX_NEED_MORE 0      // 剩下的是半帧，等更多数据
+#define GPS_DEMUX_FRAME 1          // 切出一帧
+#define GPS_DEMUX_BAD_CHECKSUM 2   // 长度对但校验失败，从同步字的下一个字节重新找
+
+typedef struct {
+    int protocol;              // GPS_PROTOCOL_*
+    const uint8_t* data;       // 帧的第一个字节（同步字）
+    uint32_t length;           // 帧长度；NMEA不含行尾的\r\n
+    uint32_t skipped;          // 帧前面跳过的字节数
+    uint32_t consumed;         // 这次一共处理掉的字节数（跳过的+帧+NMEA的行尾）
+} gps_frame_t;
+
+uint32_t rtcm3_crc24q(const uint8_t* data, uint32_t len);
+int rtcm3_verify_crc(const uint8_t* frame, uint32_t len);
+int gps_demux_next(const uint8_t* buf, uint32_t len, gps_frame_t* frame);
+
+#endif // NMEA0183_STREAMDEMUX_H
@@ -0,0 +1,125 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "TimeService.h"
+
+#if GPS_ENABLE_TIME_SERVICE
+#include <stdatomic.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#define TIME_BITS_PER_CHAR 10
+
+// 连接第unit个NTP SHM段（不存在就创建）；unit 0/1只有root可写，和ntpd的约定一致
+// 返回：0=成功，-1=空指针，-2=参数不对，-3=shmget/shmat失败
+int gps_time_service_open(gps_time_service_t* service, int unit, uint32_t baud, int64_t offset_ns) {
+    if (service == NULL) {
+        return -1;
+    }
+    if (unit < 0 || unit > 255 || baud == 0) {
+        return -2;
+    }
+    int id = shmget((key_t) (GPS_NTP_SHM_KEY + unit), sizeof(gps_ntp_shm_t), IPC_CREAT | (unit < 2 ? 0600 : 0666));
+    if (id < 0) {
+        return -3;
+    }
+    void* shm = shmat(id, NULL, 0);
+    if (shm == (void*) -1) {
+        return -3;
+    }
+    service->shm = shm;
+    service->unit = unit;
+    service->char_ns = (uint32_t) (1000000000ull * TIME_BITS_PER_CHAR / baud);
+    service->offset_ns = offset_ns;
+    memset(&service->day_cache, 0, sizeof(service->day_cache));
+    service->samples = 0;
+    service->last_clock_ns = INT64_MIN;
+    service->last_receive_ns = 0;
+    service->last_delay_ns = 0;
+    service->shm->valid = 0;
+    service->shm->mode = 1;
+    service->shm->precision = GPS_NTP_PRECISION;
+    service->shm->nsamples = 3;
+    return 0;
+}
+
+// 语句里的UTC时间（Unix纪元纳秒），没有完整日期时间返回0
+static int time_utc_ns(gps_day_cache_t* cache, int type, const gps_data_t* data, int64_t* utc_ns) {
+    if (type == GPS_SENTENCE_RMC) {
+        const gps_rmc_t* rmc = gps_data_rmc(data);
+        if (!rmc->has_time || !rmc->has_date || rmc->status != 1) {
+            return 0; // 没有定位时接收机的时间可能还没对上
+        }
+        *utc_ns = gps_day_cache_ns(cache, rmc->year, rmc->month, rmc->day) +
+                  gps_tod_ns(rmc->hour, rmc->minute, rmc->second);
+        return 1;
+    }
+    if (type == GPS_SENTENCE_ZDA) {
+        const gps_zda_t* zda = gps_data_zda(data);
+        if (!zda->has_time || !zda->has_date) {
+            return 0;
+        }
+        *utc_ns = gps_day_cache_ns(cache, zda->year, zda->month, zda->day) +
+                  gps_tod_ns(zda->hour, zda->minute, zda->second);
+        return 1;
+    }
+    return 0;
+}
+
+// 一条刚解析完的语句：arrival_ns是它第一个字节所在那次写入的CLOCK_MONOTONIC时刻，
+// queued是从这条语句第一个字节到那次写入末尾的字节数
+// 返回：1=写出了样本，0=不是时间语句或这一秒已经写过，-1=空指针
+int gps_time_service_observe(gps_time_service_t* service, int type, const gps_data_t* data, uint64_t arrival_ns,
+                             uint32_t queued) {
+    if (service == NULL || service->shm == NULL || data == NULL) {
+        return -1;
+    }
+    int64_t clock_ns;
+    if (!time_utc_ns(&service->day_cache, type, data, &clock_ns) || clock_ns <= service->last_clock_ns) {
+        return 0;
+    }
+
+    // 单调时钟 -> 系统时间；两次读取之间的偏差只有几十纳秒
+    struct timespec real;
+    struct timespec mono;
+    clock_gettime(CLOCK_REALTIME, &real);
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    int64_t real_minus_mono = ((int64_t) real.tv_sec - (int64_t) mono.tv_sec) * 1000000000LL +
+                              ((int64_t) real.tv_nsec - (int64_t) mono.tv_nsec);
+
+    int64_t delay_ns = (int64_t) queued * service->char_ns;
+    int64_t receive_ns = (int64_t) arrival_ns - delay_ns - service->offset_ns + real_minus_mono;
+
+    gps_ntp_shm_t* shm = service->shm;
+    shm->valid = 0;
+    shm->count++;
+    atomic_thread_fence(memory_order_release);
+    shm->clock_sec = (time_t) (clock_ns / 1000000000LL);
+    shm->clock_nsec = (unsigned) (clock_ns % 1000000000LL);
+    shm->clock_usec = (int) (shm->clock_nsec / 1000);
+    shm->receive_sec = (time_t) (receive_ns / 1000000000LL);
+    shm->receive_nsec = (unsigned) (receive_ns % 1000000000LL);
+    shm->receive_usec = (int) (shm->receive_nsec / 1000);
+    shm->leap = 0;
+    shm->precision = GPS_NTP_PRECISION;
+    atomic_thread_fence(memory_order_release);
+    shm->count++;
+    shm->valid = 1;
+
+    service->samples++;
+    service->last_clock_ns = clock_ns;
+    service->last_receive_ns = receive_ns;
+    service->last_delay_ns = delay_ns;
+    return 1;
+}
+
+void gps_time_service_close(gps_time_service_t* service) {
+    if (service == NULL || service->shm == NULL) {
+        return;
+    }
+    service->shm->valid = 0;
+    shmdt(service->shm);
+    service->shm = NULL;
+}
+#endif
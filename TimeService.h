@@ -0,0 +1,66 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_TIMESERVICE_H
+#define NMEA0183_TIMESERVICE_H
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+#include "Metrics.h"
+#include "GnssTime.h"
+
+// 给chrony/ntpd的SHM参考时钟（ntpd的127.127.28.N驱动，chrony的refclock SHM N）写时间样本，不需要gpsd
+// 每条RMC/ZDA第一个字节的到达时刻来自GPSSolve的到达标记（生产者写入时记录的CLOCK_MONOTONIC），
+// 再按本次写入中排在它后面的字节数×每字节传输时间往前推，得到第一个字节开始发送的时刻，
+// 减去接收机在整秒之后开始发送的固定延迟（offset_ns，需要用PPS或NTP对比标定），
+// 换算到CLOCK_REALTIME后和语句里的UTC时间配成一个样本
+// 每个UTC秒只取第一条带时间的语句（排在后面的语句传输延迟更大）
+
+#ifndef GPS_ENABLE_TIME_SERVICE
+#ifdef __linux__
+#define GPS_ENABLE_TIME_SERVICE 1
+#else
+#define GPS_ENABLE_TIME_SERVICE 0
+#endif
+#endif
+
+#define GPS_NTP_SHM_KEY 0x4E545030 // "NTP0"，第N个单元是这个值加N
+#define GPS_NTP_PRECISION (-5)     // 约30毫秒，串口NMEA时间的抖动量级
+
+// ntpd refclock_shm.c里的struct shmTime，chrony和gpsd用的是同一个布局
+typedef struct {
+    int mode;                  // 1：读取端比较前后count判断是否读到一致的样本
+    volatile int count;
+    time_t clock_sec;          // 参考时钟（GNSS）时间
+    int clock_usec;
+    time_t receive_sec;        // 同一时刻的本机系统时间
+    int receive_usec;
+    int leap;
+    int precision;
+    int nsamples;
+    volatile int valid;
+    unsigned clock_nsec;
+    unsigned receive_nsec;
+    int dummy[8];
+} gps_ntp_shm_t;
+
+typedef struct {
+    gps_ntp_shm_t* shm;
+    int unit;
+    uint32_t char_ns;          // 每字节传输时间（起始位+8数据位+停止位）
+    int64_t offset_ns;         // 接收机在整秒后多久开始发送第一条带时间的语句
+    gps_day_cache_t day_cache; // 语句日期 -> 当天0点，跨天才重新算
+    uint64_t samples;          // 写出的样本数
+    int64_t last_clock_ns;     // 上一个样本：UTC（纳秒，Unix纪元），同一时刻只写一次
+    int64_t last_receive_ns;   // 上一个样本：对应的CLOCK_REALTIME
+    int64_t last_delay_ns;     // 上一个样本按排队字节数扣掉的传输延迟；低波特率下排队几KB就超过uint32_t
+} gps_time_service_t;
+
+#if GPS_ENABLE_TIME_SERVICE
+int gps_time_service_open(gps_time_service_t* service, int unit, uint32_t baud, int64_t offset_ns);
+int gps_time_service_observe(gps_time_service_t* service, int type, const gps_data_t* data, uint64_t arrival_ns,
+                             uint32_t queued);
+void gps_time_service_close(gps_time_service_t* service);
+#endif
+
+#endif // NMEA0183_TIMESERVICE_H
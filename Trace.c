@@ -0,0 +1,167 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "Trace.h"
+
+#if GPS_ENABLE_TRACE
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+#if GPS_TRACE_USE_TSC && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define TRACE_TSC 1
+#else
+#define TRACE_TSC 0
+#endif
+
+#define TRACE_MASK (GPS_TRACE_CAPACITY - 1)
+
+_Static_assert((GPS_TRACE_CAPACITY & TRACE_MASK) == 0, "GPS_TRACE_CAPACITY must be a power of two");
+
+typedef struct {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+} trace_span_t;
+
+// 每个线程一个，只有所属线程写入
+typedef struct {
+    atomic_uint_fast64_t head;
+    uint32_t tid;
+    trace_span_t spans[GPS_TRACE_CAPACITY];
+} trace_ring_t;
+
+static _Atomic(trace_ring_t*) rings[GPS_TRACE_MAX_THREADS];
+static atomic_int ring_count;
+static _Thread_local trace_ring_t* local_ring;
+static _Thread_local int local_disabled;
+
+#if TRACE_TSC
+// 第一次注册线程时记下的 (TSC, 纳秒) 基准，导出时据此换算
+static atomic_uint_fast64_t tsc_base;
+static atomic_uint_fast64_t ns_base;
+#endif
+
+static uint64_t trace_clock_ns(void) {
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC_RAW)
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#elif defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
+
+uint64_t gps_trace_now(void) {
+#if TRACE_TSC
+    return __rdtsc();
+#else
+    return trace_clock_ns();
+#endif
+}
+
+// 线程第一次记录时分配自己的环形缓冲区
+static trace_ring_t* trace_register(void) {
+    if (local_disabled) {
+        return NULL;
+    }
+    int index = atomic_fetch_add(&ring_count, 1);
+    trace_ring_t* ring = index < GPS_TRACE_MAX_THREADS ? calloc(1, sizeof(trace_ring_t)) : NULL;
+    if (ring == NULL) {
+        local_disabled = 1;
+        return NULL;
+    }
+    ring->tid = (uint32_t) index + 1;
+#if TRACE_TSC
+    uint64_t zero = 0;
+    uint64_t tsc = __rdtsc();
+    if (atomic_compare_exchange_strong(&tsc_base, &zero, tsc)) {
+        atomic_store(&ns_base, trace_clock_ns());
+    }
+#endif
+    atomic_store_explicit(&rings[index], ring, memory_order_release);
+    local_ring = ring;
+    return ring;
+}
+
+void gps_trace_record(const char* name, uint64_t begin, uint64_t end) {
+    trace_ring_t* ring = local_ring;
+    if (ring == NULL && (ring = trace_register()) == NULL) {
+        return;
+    }
+    uint64_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    trace_span_t* span = &ring->spans[head & TRACE_MASK];
+    span->name = name;
+    span->begin = begin;
+    span->end = end;
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+// 导出所有线程的区间，返回导出的区间数；可以在记录的同时调用，正被覆盖的记录会被跳过
+int gps_trace_dump(FILE* file) {
+    if (file == NULL) {
+        return -1;
+    }
+
+    double ns_per_tick = 1.0;
+    uint64_t tick_base = 0, ns_origin = 0;
+#if TRACE_TSC
+    tick_base = atomic_load(&tsc_base);
+    ns_origin = atomic_load(&ns_base);
+    uint64_t tsc_now = __rdtsc();
+    uint64_t ns_now = trace_clock_ns();
+    if (tsc_now > tick_base && ns_now > ns_origin) {
+        ns_per_tick = (double) (ns_now - ns_origin) / (double) (tsc_now - tick_base);
+    }
+#endif
+
+    trace_span_t* copy = malloc(sizeof(trace_span_t) * GPS_TRACE_CAPACITY);
+    if (copy == NULL) {
+        return -1;
+    }
+
+    int written = 0;
+    fprintf(file, "{\"traceEvents\":[");
+    int threads = atomic_load(&ring_count);
+    if (threads > GPS_TRACE_MAX_THREADS) {
+        threads = GPS_TRACE_MAX_THREADS;
+    }
+    for (int t = 0; t < threads; t++) {
+        trace_ring_t* ring = atomic_load_explicit(&rings[t], memory_order_acquire);
+        if (ring == NULL) {
+            continue;
+        }
+        uint64_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint64_t first = head > GPS_TRACE_CAPACITY ? head - GPS_TRACE_CAPACITY : 0;
+        for (uint64_t i = first; i < head; i++) {
+            copy[i & TRACE_MASK] = ring->spans[i & TRACE_MASK];
+        }
+        atomic_thread_fence(memory_order_acquire);
+        // 复制期间写入端又写了多少条，就有多少条旧记录可能已被覆盖
+        uint64_t head_after = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        if (head_after >= GPS_TRACE_CAPACITY && head_after - GPS_TRACE_CAPACITY + 1 > first) {
+            first = head_after - GPS_TRACE_CAPACITY + 1;
+        }
+
+        for (uint64_t i = first; i < head; i++) {
+            const trace_span_t* span = &copy[i & TRACE_MASK];
+            double begin_us = (ns_origin + (double) (int64_t) (span->begin - tick_base) * ns_per_tick) / 1000.0;
+            double dur_us = (span->end - span->begin) * ns_per_tick / 1000.0;
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                    written > 0 ? ",\n" : "\n", span->name, begin_us, dur_us, ring->tid);
+            written++;
+        }
+    }
+    fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+    free(copy);
+    return written;
+}
+#else
+int gps_trace_dump(FILE* file) {
+    (void) file;
+    return -2;
+}
+#endif
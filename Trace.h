@@ -0,0 +1,45 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_TRACE_H
+#define NMEA0183_TRACE_H
+#include <stdint.h>
+#include <stdio.h>
+
+// 周期级耗时追踪，导出为Chrome/Perfetto的trace JSON（chrome://tracing 或 ui.perfetto.dev 打开）
+// 编译时用 -DGPS_ENABLE_TRACE=1 打开；关闭时所有埋点宏展开为空，没有任何开销
+// 每个线程把区间写进自己的环形缓冲区，写满后覆盖最旧的记录，不加锁
+
+#ifndef GPS_ENABLE_TRACE
+#define GPS_ENABLE_TRACE 0
+#endif
+
+#ifndef GPS_TRACE_CAPACITY
+#define GPS_TRACE_CAPACITY 8192 // 每个线程保存的区间数，必须是2的幂
+#endif
+
+#ifndef GPS_TRACE_MAX_THREADS
+#define GPS_TRACE_MAX_THREADS 16
+#endif
+
+// x86上可以用rdtsc代替clock_gettime，导出时按单调时钟换算成微秒
+#ifndef GPS_TRACE_USE_TSC
+#define GPS_TRACE_USE_TSC 0
+#endif
+
+#if GPS_ENABLE_TRACE
+uint64_t gps_trace_now(void);
+void gps_trace_record(const char* name, uint64_t begin, uint64_t end);
+
+// 用法：GPS_TRACE_BEGIN(t); ...; GPS_TRACE_END(t, "name");  name必须是静态生存期的字符串
+#define GPS_TRACE_BEGIN(var) uint64_t var = gps_trace_now()
+#define GPS_TRACE_END(var, name) gps_trace_record((name), (var), gps_trace_now())
+#else
+#define GPS_TRACE_BEGIN(var)
+#define GPS_TRACE_END(var, name)
+#endif
+
+int gps_trace_dump(FILE* file);
+
+#endif // NMEA0183_TRACE_H
@@ -0,0 +1,173 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "TrackSimplifySolve.h"
+
+#define SIMPLIFY_EARTH_RADIUS 6371000.0     // 与calculate_distance保持一致
+#define SIMPLIFY_KNOTS_TO_MS 0.514444444    // 节 -> 米/秒
+#define SIMPLIFY_KMH_TO_MS (1.0 / 3.6)      // 公里/小时 -> 米/秒
+
+void gps_simplify_default_config(gps_simplify_config_t* config) {
+    config->tolerance = 5.0;
+    config->max_course_change = 15.0;
+    config->max_speed_change = 3.0;
+    config->min_course_speed = 1.0;
+    config->max_interval = 60.0;
+}
+
+void gps_simplify_init(gps_simplifier_t* simplifier, const gps_simplify_config_t* config) {
+    memset(simplifier, 0, sizeof(gps_simplifier_t));
+    if (config != NULL) {
+        simplifier->config = *config;
+    } else {
+        gps_simplify_default_config(&simplifier->config);
+    }
+}
+
+// 点到起点推算位置的偏差（米），小范围内用等距圆柱投影近似
+static double simplify_deviation(const gps_track_point_t* anchor, const gps_track_point_t* point) {
+    double meters_per_deg = SIMPLIFY_EARTH_RADIUS * M_PI / 180.0;
+    double north = (point->latitude - anchor->latitude) * meters_per_deg;
+    double dlon = point->longitude - anchor->longitude;
+    if (dlon >= 180.0) {
+        dlon -= 360.0;
+    } else if (dlon < -180.0) {
+        dlon += 360.0;
+    }
+    double east = dlon * meters_per_deg * cos(anchor->latitude * M_PI / 180.0);
+
+    if (anchor->has_velocity) {
+        double dt = point->timestamp - anchor->timestamp;
+        double rad = anchor->course * M_PI / 180.0;
+        east -= anchor->speed * dt * sin(rad);
+        north -= anchor->speed * dt * cos(rad);
+    }
+    return sqrt(east * east + north * north);
+}
+
+// 判断point能否由anchor推算得到
+static int simplify_predictable(const gps_simplify_config_t* config, const gps_track_point_t* anchor,
+                                const gps_track_point_t* point) {
+    if (config->max_interval > 0.0 && point->timestamp - anchor->timestamp > config->max_interval) {
+        return 0;
+    }
+    if (anchor->has_velocity && point->has_velocity) {
+        if (config->max_speed_change > 0.0 && fabs(point->speed - anchor->speed) > config->max_speed_change) {
+            return 0;
+        }
+        if (config->max_course_change > 0.0 && anchor->speed >= config->min_course_speed &&
+            point->speed >= config->min_course_speed) {
+            double dc = fabs(point->course - anchor->course);
+            if (dc > 180.0) {
+                dc = 360.0 - dc;
+            }
+            if (dc > config->max_course_change) {
+                return 0;
+            }
+        }
+    }
+    return simplify_deviation(anchor, point) <= config->tolerance;
+}
+
+// 输入一个点，返回需要保留的点数（0~GPS_SIMPLIFY_MAX_OUT），按时间顺序写入out
+int gps_simplify_push(gps_simplifier_t* simplifier, const gps_track_point_t* point, gps_track_point_t* out) {
+    if (simplifier == NULL || point == NULL || out == NULL) {
+        return -1;
+    }
+    simplifier->input_count++;
+
+    if (!simplifier->has_anchor) {
+        simplifier->anchor = *point;
+        simplifier->has_anchor = 1;
+        out[0] = *point;
+        simplifier->output_count++;
+        return 1;
+    }
+
+    if (simplify_predictable(&simplifier->config, &simplifier->anchor, point)) {
+        simplifier->pending = *point;
+        simplifier->has_pending = 1;
+        return 0;
+    }
+
+    // 偏离后保留上一个仍在容差内的点；紧跟在起点后面就偏离的点直接保留
+    if (simplifier->has_pending) {
+        out[0] = simplifier->pending;
+        simplifier->anchor = simplifier->pending;
+        simplifier->output_count++;
+        if (simplify_predictable(&simplifier->config, &simplifier->anchor, point)) {
+            simplifier->pending = *point;
+            return 1;
+        }
+        // 当前点相对新起点也偏离（连续两个拐点），同样保留，否则会被下一个点覆盖掉
+        out[1] = *point;
+        simplifier->anchor = *point;
+        simplifier->has_pending = 0;
+        simplifier->output_count++;
+        return 2;
+    }
+    out[0] = *point;
+    simplifier->anchor = *point;
+    simplifier->output_count++;
+    return 1;
+}
+
+// 从一个历元取出轨迹点，位置优先GGA，速度优先RMC
+// 定位语句的时刻没有前进（上一个历元留下的旧数据）返回-4，旧位置配上新时刻会被当成静止的点
+// 返回值和out的大小同gps_simplify_push
+int gps_simplify_push_epoch(gps_simplifier_t* simplifier, const gps_data_t* data, double timestamp,
+                            gps_track_point_t* out) {
+    if (simplifier == NULL || data == NULL) {
+        return -1;
+    }
+
+    const gps_gga_t* gga = gps_data_gga(data);
+    const gps_rmc_t* rmc = gps_data_rmc(data);
+    const gps_vtg_t* vtg = gps_data_vtg(data);
+    gps_track_point_t point = {0};
+    point.timestamp = timestamp;
+    int fresh;
+    if (gga->has_latitude && gga->has_longitude && gga->fix_quality > 0) {
+        point.latitude = GPS_TO_DOUBLE(gga->latitude, DEGREE);
+        point.longitude = GPS_TO_DOUBLE(gga->longitude, DEGREE);
+        fresh = !gga->has_time || gps_tod_mark_advance(&simplifier->fix_mark, gga->hour, gga->minute, gga->second);
+    } else if (rmc->has_latitude && rmc->has_longitude && rmc->status == 1) {
+        point.latitude = GPS_TO_DOUBLE(rmc->latitude, DEGREE);
+        point.longitude = GPS_TO_DOUBLE(rmc->longitude, DEGREE);
+        fresh = !rmc->has_time || gps_tod_mark_advance(&simplifier->fix_mark, rmc->hour, rmc->minute, rmc->second);
+    } else {
+        return -2;
+    }
+    if (!fresh) {
+        return -4;
+    }
+
+    if (rmc->has_speed && rmc->has_course) {
+        point.speed = GPS_TO_DOUBLE(rmc->speed_over_ground, SPEED) * SIMPLIFY_KNOTS_TO_MS;
+        point.course = GPS_TO_DOUBLE(rmc->course_over_ground, ANGLE);
+        point.has_velocity = 1;
+    } else if (vtg->has_true_course && (vtg->has_speed_kmh || vtg->has_speed_knots)) {
+        point.speed = vtg->has_speed_kmh ? GPS_TO_DOUBLE(vtg->speed_kmh, SPEED) * SIMPLIFY_KMH_TO_MS
+                                        : GPS_TO_DOUBLE(vtg->speed_knots, SPEED) * SIMPLIFY_KNOTS_TO_MS;
+        point.course = GPS_TO_DOUBLE(vtg->course_true, ANGLE);
+        point.has_velocity = 1;
+    }
+
+    return gps_simplify_push(simplifier, &point, out);
+}
+
+// 轨迹结束时输出最后一个未保留的点
+int gps_simplify_flush(gps_simplifier_t* simplifier, gps_track_point_t* out) {
+    if (simplifier == NULL || out == NULL) {
+        return -1;
+    }
+    if (!simplifier->has_pending) {
+        return 0;
+    }
+    *out = simplifier->pending;
+    simplifier->anchor = simplifier->pending;
+    simplifier->has_pending = 0;
+    simplifier->output_count++;
+    return 1;
+}
@@ -0,0 +1,54 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_TRACKSIMPLIFYSOLVE_H
+#define NMEA0183_TRACKSIMPLIFYSOLVE_H
+#include "NMEA0183Solve.h"
+#include "GnssTime.h"
+
+// 流式轨迹抽稀（航位推算死区压缩）
+// 用最近保留点的速度和航向推算当前位置，实际位置偏离推算位置超过容差、航向或速度变化过大、
+// 或者间隔过长时，保留偏离前的最后一个点作为新的起点。每个点只做常数次计算，只保存两个点
+
+#define GPS_SIMPLIFY_MAX_OUT 2     // gps_simplify_push一次最多输出的点数，out至少要有这么大
+
+// 抽稀参数
+typedef struct {
+    double tolerance;          // 位置容差（米）
+    double max_course_change;  // 航向变化阈值（度），<=0表示不检查
+    double max_speed_change;   // 速度变化阈值（米/秒），<=0表示不检查
+    double min_course_speed;   // 低于此速度时航向不可信，不检查航向变化（米/秒）
+    double max_interval;       // 两个保留点的最大间隔（秒），<=0表示不限制
+} gps_simplify_config_t;
+
+typedef struct {
+    double latitude;           // 纬度（度）
+    double longitude;          // 经度（度）
+    double speed;              // 地面速率（米/秒）
+    double course;             // 地面航向（度）
+    double timestamp;          // 时刻（秒）
+    int has_velocity;          // 是否有速度和航向
+} gps_track_point_t;
+
+typedef struct {
+    gps_simplify_config_t config;
+
+    gps_track_point_t anchor;  // 最近一个保留点
+    gps_track_point_t pending; // 最近一个未保留的点
+    int has_anchor;
+    int has_pending;
+
+    uint64_t input_count;      // 输入点数
+    uint64_t output_count;     // 保留点数
+    gps_tod_mark_t fix_mark;   // gps_simplify_push_epoch上次用的定位语句时刻
+} gps_simplifier_t;
+
+void gps_simplify_default_config(gps_simplify_config_t* config);
+void gps_simplify_init(gps_simplifier_t* simplifier, const gps_simplify_config_t* config);
+int gps_simplify_push(gps_simplifier_t* simplifier, const gps_track_point_t* point, gps_track_point_t* out);
+int gps_simplify_push_epoch(gps_simplifier_t* simplifier, const gps_data_t* data, double timestamp,
+                            gps_track_point_t* out);
+int gps_simplify_flush(gps_simplifier_t* simplifier, gps_track_point_t* out);
+
+#endif // NMEA0183_TRACKSIMPLIFYSOLVE_H
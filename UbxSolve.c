@@ -0,0 +1,607 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "UbxSolve.h"
+
+// 校验一帧UBX：len是缓冲区里从同步字开始的可用字节数
+// 返回：0=正确，-1=空指针，-2=同步字不对，-3=帧不完整，-5=校验和错误
+int ubx_verify_checksum(const uint8_t* frame, uint32_t len) {
+    if (frame == NULL) {
+        return -1;
+    }
+    if (len < UBX_FRAME_OVERHEAD) {
+        return -3;
+    }
+    if (frame[0] != UBX_SYNC_CHAR_1 || frame[1] != UBX_SYNC_CHAR_2) {
+        return -2;
+    }
+    uint32_t payload_len = ubx_u16(frame + 4);
+    if (len < payload_len + UBX_FRAME_OVERHEAD) {
+        return -3;
+    }
+
+    uint8_t ck_a = 0, ck_b = 0;
+    const uint8_t* end = frame + UBX_HEADER_SIZE + payload_len;
+    for (const uint8_t* p = frame + 2; p < end; p++) {
+        ck_a += *p;
+        ck_b += ck_a;
+    }
+    return (ck_a == end[0] && ck_b == end[1]) ? 0 : -5;
+}
+
+#if GPS_ENABLE_UBX
+// UBX里的整数是 raw×10^-digits，换算成对应的gps_xxx_t
+#if GPS_INTEGER_ONLY
+static int32_t ubx_scale(int64_t raw, int digits, int target_digits) {
+    int64_t divisor = 1;
+    for (int i = target_digits; i < digits; i++) {
+        divisor *= 10;
+    }
+    if (divisor > 1) {
+        raw = (raw + (raw < 0 ? -divisor / 2 : divisor / 2)) / divisor; // 四舍五入
+    }
+    for (int i = digits; i < target_digits; i++) {
+        raw *= 10;
+    }
+    if (raw > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (raw < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t) raw;
+}
+#define UBX_VALUE(raw, digits, KIND) ubx_scale((raw), (digits), GPS_##KIND##_DIGITS)
+#else
+static const double ubx_pow10[10] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+#define UBX_VALUE(raw, digits, KIND) ((double) (raw) / ubx_pow10[digits])
+#endif
+
+#define NANOS_PER_DAY 86400000000000LL
+
+// 一个历元里NAV-PVT解出来的公共字段，再分发给各语句的结构体
+typedef struct {
+    int has_time;
+    int hour;
+    int minute;
+    gps_second_t second;
+    gps_tod_t utc_time;
+
+    int has_date;
+    int day;
+    int month;
+    int year;
+
+    int has_position;
+    gps_degree_t latitude;
+    gps_degree_t latitude_degrees;
+    gps_minute_t latitude_minutes;
+    gps_degree_t longitude;
+    gps_degree_t longitude_degrees;
+    gps_minute_t longitude_minutes;
+    int is_north;
+    int is_east;
+
+    int fix_ok;
+    int fix_type;
+    int mode;                  // 和NMEA的模式指示一样：0=自主，1=差分，2=估算，3=无效
+    int fix_quality;           // 和GGA的定位质量一样
+    int satellites_used;
+
+    gps_meter_t altitude;
+    gps_meter_t geoid_height;
+
+    int has_speed;
+    gps_speed_t speed_knots;
+    gps_speed_t speed_kmh;
+    int has_course;
+    gps_angle_t course;
+
+    int has_magnetic_variation;
+    gps_angle_t magnetic_variation; // 东为正
+} ubx_pvt_t;
+
+// 1e-7度的坐标拆成度、分两部分（都取绝对值，和NMEA的度分格式一致）
+static void ubx_split_degrees(int32_t raw, gps_degree_t* degrees, gps_minute_t* minutes) {
+    int64_t a = raw < 0 ? -(int64_t) raw : raw;
+    *degrees = UBX_VALUE(a / 10000000 * 10000000, 7, DEGREE);
+    *minutes = UBX_VALUE(a % 10000000 * 60, 7, MINUTE);
+}
+
+static void ubx_decode_pvt(const uint8_t* p, ubx_pvt_t* pvt) {
+    uint8_t valid = p[11];
+    uint8_t fix_type = p[20];
+    uint8_t flags = p[21];
+    int carrier = flags >> 6;  // 载波相位解：1=浮点，2=固定
+
+    memset(pvt, 0, sizeof(ubx_pvt_t));
+
+    // 时分秒是取整后的值，真正的时刻还要加上nano（可能为负）
+    int hour = p[8], minute = p[9], sec = p[10];
+    if ((valid & 0x02) && hour <= 23 && minute <= 59 && sec <= 59) {
+        int64_t tod = ((int64_t) (hour * 60 + minute) * 60 + sec) * 1000000000LL + ubx_i32(p + 16);
+        if (tod < 0) {
+            tod += NANOS_PER_DAY;
+        } else if (tod >= NANOS_PER_DAY) {
+            tod -= NANOS_PER_DAY;
+        }
+        pvt->hour = (int) (tod / 3600000000000LL);
+        pvt->minute = (int) (tod / 60000000000LL % 60);
+        pvt->second = UBX_VALUE(tod % 60000000000LL, 9, SECOND);
+        pvt->utc_time = GPS_UTC_TIME(pvt->hour, pvt->minute, pvt->second);
+        pvt->has_time = 1;
+    }
+
+    int year = ubx_u16(p + 4), month = p[6], day = p[7];
+    if ((valid & 0x01) && month >= 1 && month <= 12 && day >= 1 && day <= 31) {
+        pvt->year = year;
+        pvt->month = month;
+        pvt->day = day;
+        pvt->has_date = 1;
+    }
+
+    pvt->fix_type = fix_type;
+    pvt->fix_ok = (flags & 0x01) && fix_type >= 1 && fix_type <= 4;
+    if (!pvt->fix_ok) {
+        pvt->mode = 3;
+        pvt->fix_quality = 0;
+    } else if (fix_type == 1) {
+        pvt->mode = 2;         // 只有航位推算
+        pvt->fix_quality = 6;
+    } else if (carrier == 2) {
+        pvt->mode = 1;
+        pvt->fix_quality = 4;  // RTK固定解
+    } else if (carrier == 1) {
+        pvt->mode = 1;
+        pvt->fix_quality = 5;  // RTK浮点解
+    } else if (flags & 0x02) {
+        pvt->mode = 1;
+        pvt->fix_quality = 2;
+    } else {
+        pvt->mode = 0;
+        pvt->fix_quality = 1;
+    }
+    pvt->satellites_used = p[23];
+
+    // flags3 bit0：经纬高无效
+    if (fix_type >= 1 && fix_type <= 4 && !(ubx_u16(p + 78) & 0x01)) {
+        int32_t lon = ubx_i32(p + 24);
+        int32_t lat = ubx_i32(p + 28);
+        pvt->latitude = UBX_VALUE(lat, 7, DEGREE);
+        pvt->longitude = UBX_VALUE(lon, 7, DEGREE);
+        ubx_split_degrees(lat, &pvt->latitude_degrees, &pvt->latitude_minutes);
+        ubx_split_degrees(lon, &pvt->longitude_degrees, &pvt->longitude_minutes);
+        pvt->is_north = lat >= 0;
+        pvt->is_east = lon >= 0;
+        int32_t height = ubx_i32(p + 32);
+        int32_t msl = ubx_i32(p + 36);
+        pvt->altitude = UBX_VALUE(msl, 3, METER);
+        pvt->geoid_height = UBX_VALUE((int64_t) height - msl, 3, METER);
+        pvt->has_position = 1;
+    }
+
+    // 地速mm/s换算成节和公里/小时（保留6位小数再换算到目标精度）
+    int32_t ground_speed = ubx_i32(p + 60);
+    if (pvt->fix_ok && ground_speed >= 0) {
+        pvt->speed_knots = UBX_VALUE((int64_t) ground_speed * 3600000 / 1852, 6, SPEED);
+        pvt->speed_kmh = UBX_VALUE((int64_t) ground_speed * 3600, 6, SPEED);
+        pvt->has_speed = pvt->speed_knots <= GPS_CONST(999.9, SPEED);
+    }
+    int32_t heading = ubx_i32(p + 64); // 1e-5度
+    if (pvt->fix_ok && heading >= 0 && heading <= 36000000) {
+        pvt->course = UBX_VALUE(heading == 36000000 ? 0 : heading, 5, ANGLE);
+        pvt->has_course = 1;
+    }
+
+    // valid bit3：磁偏角有效
+    if (valid & 0x08) {
+        pvt->magnetic_variation = UBX_VALUE(ubx_i16(p + 88), 2, ANGLE);
+        pvt->has_magnetic_variation = 1;
+    }
+}
+
+// 解析NAV-PVT，填写GGA/RMC/VTG/GLL/ZDA以及GSA的定位模式
+// 返回：0=成功，-1=空指针，-4=负载长度不对
+int parse_ubx_nav_pvt(const uint8_t* payload, uint16_t length, gps_data_t* data) {
+    if (payload == NULL || data == NULL) {
+        return -1;
+    }
+    if (length < UBX_NAV_PVT_LENGTH) {
+        return -4;
+    }
+    ubx_pvt_t pvt;
+    ubx_decode_pvt(payload, &pvt);
+
+#if GPS_ENABLE_GGA
+    {
+        gps_gga_t* gga = &data->gga;
+        // hdop来自NAV-DOP，可能先于NAV-PVT到达，保留下来
+        gps_dop_t hdop = gga->hdop;
+        int has_hdop = gga->has_hdop;
+        memset(gga, 0, sizeof(gps_gga_t));
+        gga->utc_time = -1.0;
+        gga->latitude = GPS_NAN;
+        gga->longitude = GPS_NAN;
+        gga->hdop = has_hdop ? hdop : -1.0;
+        gga->has_hdop = has_hdop;
+        gga->altitude = GPS_NAN;
+        gga->geoid_height = GPS_NAN;
+        gga->diff_age = -1.0;
+        if (pvt.has_time) {
+            gga->hour = pvt.hour;
+            gga->minute = pvt.minute;
+            gga->second = pvt.second;
+            gga->utc_time = pvt.utc_time;
+            gga->has_time = 1;
+        }
+        if (pvt.has_position) {
+            gga->latitude = pvt.latitude;
+            gga->latitude_degrees = pvt.latitude_degrees;
+            gga->latitude_minutes = pvt.latitude_minutes;
+            gga->is_north = pvt.is_north;
+            gga->has_latitude = 1;
+            gga->longitude = pvt.longitude;
+            gga->longitude_degrees = pvt.longitude_degrees;
+            gga->longitude_minutes = pvt.longitude_minutes;
+            gga->is_east = pvt.is_east;
+            gga->has_longitude = 1;
+            gga->altitude = pvt.altitude;
+            gga->has_altitude = 1;
+            gga->geoid_height = pvt.geoid_height;
+            gga->has_geoid_height = 1;
+        }
+        gga->fix_quality = pvt.fix_quality;
+        gga->has_fix_quality = 1;
+        gga->satellites_used = pvt.satellites_used;
+        gga->has_satellites = 1;
+    }
+#endif
+
+#if GPS_ENABLE_RMC
+    {
+        gps_rmc_t* rmc = &data->rmc;
+        memset(rmc, 0, sizeof(gps_rmc_t));
+        rmc->utc_time = -1.0;
+        rmc->latitude = GPS_NAN;
+        rmc->longitude = GPS_NAN;
+        rmc->speed_over_ground = -1.0;
+        rmc->course_over_ground = -1.0;
+        rmc->day = -1;
+        rmc->month = -1;
+        rmc->year = -1;
+        rmc->magnetic_variation = GPS_NAN;
+        rmc->is_magnetic_east = -1;
+        if (pvt.has_time) {
+            rmc->hour = pvt.hour;
+            rmc->minute = pvt.minute;
+            rmc->second = pvt.second;
+            rmc->utc_time = pvt.utc_time;
+            rmc->has_time = 1;
+        }
+        rmc->status = pvt.fix_ok;
+        rmc->has_status = 1;
+        if (pvt.has_position) {
+            rmc->latitude = pvt.latitude;
+            rmc->latitude_degrees = pvt.latitude_degrees;
+            rmc->latitude_minutes = pvt.latitude_minutes;
+            rmc->is_north = pvt.is_north;
+            rmc->has_latitude = 1;
+            rmc->longitude = pvt.longitude;
+            rmc->longitude_degrees = pvt.longitude_degrees;
+            rmc->longitude_minutes = pvt.longitude_minutes;
+            rmc->is_east = pvt.is_east;
+            rmc->has_longitude = 1;
+        }
+        if (pvt.has_speed) {
+            rmc->speed_over_ground = pvt.speed_knots;
+            rmc->has_speed = 1;
+        }
+        if (pvt.has_course) {
+            rmc->course_over_ground = pvt.course;
+            rmc->has_course = 1;
+        }
+        if (pvt.has_date) {
+            rmc->day = pvt.day;
+            rmc->month = pvt.month;
+            rmc->year = pvt.year;
+            rmc->has_date = 1;
+        }
+        if (pvt.has_magnetic_variation) {
+            rmc->magnetic_variation = pvt.magnetic_variation;
+            rmc->is_magnetic_east = pvt.magnetic_variation >= 0;
+            rmc->has_magnetic_variation = 1;
+        }
+        rmc->mode_indicator = pvt.mode;
+        rmc->has_mode = 1;
+    }
+#endif
+
+#if GPS_ENABLE_VTG
+    {
+        gps_vtg_t* vtg = &data->vtg;
+        memset(vtg, 0, sizeof(gps_vtg_t));
+        vtg->course_true = -1.0;
+        vtg->course_magnetic = -1.0;
+        vtg->speed_knots = -1.0;
+        vtg->speed_kmh = -1.0;
+        if (pvt.has_course) {
+            vtg->course_true = pvt.course;
+            vtg->has_true_course = 1;
+        }
+        if (pvt.has_speed) {
+            vtg->speed_knots = pvt.speed_knots;
+            vtg->has_speed_knots = 1;
+            vtg->speed_kmh = pvt.speed_kmh;
+            vtg->has_speed_kmh = 1;
+        }
+        vtg->mode = pvt.mode;
+        vtg->has_mode = 1;
+    }
+#endif
+
+#if GPS_ENABLE_GLL
+    {
+        gps_gll_t* gll = &data->gll;
+        memset(gll, 0, sizeof(gps_gll_t));
+        gll->latitude = GPS_NAN;
+        gll->longitude = GPS_NAN;
+        gll->utc_time = -1.0;
+        if (pvt.has_position) {
+            gll->latitude = pvt.latitude;
+            gll->latitude_degrees = pvt.latitude_degrees;
+            gll->latitude_minutes = pvt.latitude_minutes;
+            gll->is_north = pvt.is_north;
+            gll->has_latitude = 1;
+            gll->longitude = pvt.longitude;
+            gll->longitude_degrees = pvt.longitude_degrees;
+            gll->longitude_minutes = pvt.longitude_minutes;
+            gll->is_east = pvt.is_east;
+            gll->has_longitude = 1;
+        }
+        if (pvt.has_time) {
+            gll->hour = pvt.hour;
+            gll->minute = pvt.minute;
+            gll->second = pvt.second;
+            gll->utc_time = pvt.utc_time;
+            gll->has_time = 1;
+        }
+        gll->data_valid = pvt.fix_ok;
+        gll->has_data_valid = 1;
+        gll->mode_indicator = pvt.mode;
+        gll->has_mode = 1;
+    }
+#endif
+
+#if GPS_ENABLE_ZDA
+    {
+        gps_zda_t* zda = &data->zda;
+        memset(zda, 0, sizeof(gps_zda_t));
+        zda->utc_time = -1.0;
+        if (pvt.has_time) {
+            zda->hour = pvt.hour;
+            zda->minute = pvt.minute;
+            zda->second = pvt.second;
+            zda->utc_time = pvt.utc_time;
+            zda->has_time = 1;
+        }
+        if (pvt.has_date) {
+            zda->day = pvt.day;
+            zda->month = pvt.month;
+            zda->year = pvt.year;
+            zda->has_date = 1;
+        }
+    }
+#endif
+
+#if GPS_ENABLE_GSA
+    // 卫星列表来自NAV-SAT，这里只更新定位模式
+    for (int i = 0; i < MAX_KIND_OF_SATELLITE; i++) {
+        gps_gsa_t* gsa = &data->satellites.gsa[i];
+        gsa->mode1 = 2;
+        gsa->has_mode1 = 1;
+        gsa->mode2 = !pvt.fix_ok || pvt.fix_type == 1 ? 1 : (pvt.fix_type == 2 ? 2 : 3);
+        gsa->has_mode2 = 1;
+    }
+#endif
+    return 0;
+}
+
+// DOP范围检查和GSA/GGA解析函数一致
+static int ubx_dop(const uint8_t* p, gps_dop_t* dop) {
+    gps_dop_t value = UBX_VALUE(ubx_u16(p), 2, DOP);
+    if (value > GPS_CONST(99.9, DOP)) {
+        *dop = -1.0;
+        return 0;
+    }
+    *dop = value;
+    return 1;
+}
+
+// 解析NAV-DOP，填写GGA的hdop和每个GSA的pdop/hdop/vdop
+int parse_ubx_nav_dop(const uint8_t* payload, uint16_t length, gps_data_t* data) {
+    if (payload == NULL || data == NULL) {
+        return -1;
+    }
+    if (length < UBX_NAV_DOP_LENGTH) {
+        return -4;
+    }
+#if GPS_ENABLE_GGA
+    data->gga.has_hdop = ubx_dop(payload + 12, &data->gga.hdop);
+#endif
+#if GPS_ENABLE_GSA
+    for (int i = 0; i < MAX_KIND_OF_SATELLITE; i++) {
+        gps_gsa_t* gsa = &data->satellites.gsa[i];
+        gsa->has_pdop = ubx_dop(payload + 6, &gsa->pdop);
+        gsa->has_vdop = ubx_dop(payload + 10, &gsa->vdop);
+        gsa->has_hdop = ubx_dop(payload + 12, &gsa->hdop);
+    }
+#endif
+    return 0;
+}
+
+#if GPS_ENABLE_SATELLITES
+// NMEA里的系统标识（语句头第二个字符），SBAS在NMEA里归到GPS
+static char ubx_system_id(int gnss) {
+    switch (gnss) {
+        case UBX_GNSS_GPS: return 'P';
+        case UBX_GNSS_GALILEO: return 'A';
+        case UBX_GNSS_BEIDOU: return 'B';
+        case UBX_GNSS_QZSS: return 'Q';
+        case UBX_GNSS_GLONASS: return 'L';
+        default: return 'N';
+    }
+}
+
+// 换算成NMEA的卫星编号：SBAS 120~158 -> 33~64，GLONASS 1~32 -> 65~96
+static int ubx_nmea_prn(int gnss, int sv) {
+    switch (gnss) {
+        case UBX_GNSS_SBAS: return sv >= 120 ? sv - 87 : sv;
+        case UBX_GNSS_GLONASS: return sv <= 32 ? sv + 64 : sv;
+        default: return sv;
+    }
+}
+
+// 解析NAV-SAT，按系统分组填写GSV卫星表和GSA的在用卫星列表
+// 系统按第一次出现的顺序占用槽位，超出MAX_KIND_OF_SATELLITE的系统、超出EACH_KIND_OF_SATELLITE*4颗的卫星不记录
+int parse_ubx_nav_sat(const uint8_t* payload, uint16_t length, gps_data_t* data) {
+    if (payload == NULL || data == NULL) {
+        return -1;
+    }
+    int count = payload[5];
+    if (length < UBX_NAV_SAT_HEADER || length < UBX_NAV_SAT_HEADER + count * UBX_NAV_SAT_BLOCK) {
+        return -4;
+    }
+
+    gps_satellites* satellites = &data->satellites;
+    int systems[MAX_KIND_OF_SATELLITE];
+    int seen[MAX_KIND_OF_SATELLITE] = {0};
+    int system_count = 0;
+
+#if GPS_ENABLE_GSV
+    for (int s = 0; s < MAX_KIND_OF_SATELLITE; s++) {
+        for (int m = 0; m < EACH_KIND_OF_SATELLITE; m++) {
+            gps_gsv_t* gsv = &satellites->gsv[s][m];
+            memset(gsv, 0, sizeof(gps_gsv_t));
+            gsv->total_messages = -1;
+            gsv->message_number = -1;
+            gsv->total_satellites = -1;
+            for (int i = 0; i < 4; i++) {
+                gsv->satellites[i].prn = -1;
+                gsv->satellites[i].elevation = -1;
+                gsv->satellites[i].azimuth = -1;
+                gsv->satellites[i].snr = -1;
+            }
+        }
+    }
+#endif
+#if GPS_ENABLE_GSA
+    for (int s = 0; s < MAX_KIND_OF_SATELLITE; s++) {
+        gps_gsa_t* gsa = &satellites->gsa[s];
+        gsa->satellite_count = 0;
+        for (int i = 0; i < 12; i++) {
+            gsa->satellites[i] = -1;
+        }
+        gsa->system_id = 0;
+        gsa->has_system_id = 0;
+    }
+#endif
+
+    for (int i = 0; i < count; i++) {
+        const uint8_t* block = payload + UBX_NAV_SAT_HEADER + i * UBX_NAV_SAT_BLOCK;
+        int gnss = block[0] == UBX_GNSS_SBAS ? UBX_GNSS_GPS : block[0];
+        int slot = 0;
+        while (slot < system_count && systems[slot] != gnss) {
+            slot++;
+        }
+        if (slot == system_count) {
+            if (system_count == MAX_KIND_OF_SATELLITE) {
+                continue;
+            }
+            systems[system_count++] = gnss;
+        }
+        int prn = ubx_nmea_prn(block[0], block[1]);
+        int index = seen[slot]++;
+
+#if GPS_ENABLE_GSV
+        if (index < EACH_KIND_OF_SATELLITE * 4) {
+            gps_gsv_t* gsv = &satellites->gsv[slot][index / 4];
+            satellite_info_t* info = &gsv->satellites[gsv->satellite_count++];
+            int elevation = (int8_t) block[3];
+            int azimuth = ubx_i16(block + 4);
+            info->prn = prn;
+            info->elevation = elevation >= 0 && elevation <= 90 ? elevation : -1;
+            info->azimuth = azimuth >= 0 && azimuth <= 359 ? azimuth : -1;
+            info->snr = block[2] > 0 && block[2] <= 99 ? block[2] : -1; // 没跟踪上时cno为0，NMEA里是空
+            info->is_valid = 1;
+        }
+#else
+        (void) index;
+#endif
+#if GPS_ENABLE_GSA
+        // flags bit3：参与定位
+        gps_gsa_t* gsa = &satellites->gsa[slot];
+        if ((ubx_u32(block + 8) & 0x08) && gsa->satellite_count < 12) {
+            gsa->satellites[gsa->satellite_count++] = prn;
+        }
+#endif
+    }
+
+    for (int s = 0; s < system_count; s++) {
+        char system_id = ubx_system_id(systems[s]);
+#if GPS_ENABLE_GSV
+        int messages = (seen[s] + 3) / 4;
+        for (int m = 0; m < messages && m < EACH_KIND_OF_SATELLITE; m++) {
+            gps_gsv_t* gsv = &satellites->gsv[s][m];
+            if (messages <= 9) {
+                gsv->total_messages = messages;
+                gsv->has_total_messages = 1;
+            }
+            gsv->message_number = m + 1;
+            gsv->has_message_number = 1;
+            if (seen[s] <= 99) {
+                gsv->total_satellites = seen[s];
+                gsv->has_total_satellites = 1;
+            }
+            gsv->system_id = system_id;
+            gsv->has_system_id = 1;
+        }
+#endif
+#if GPS_ENABLE_GSA
+        satellites->gsa[s].system_id = system_id;
+        satellites->gsa[s].has_system_id = 1;
+#endif
+    }
+    return 0;
+}
+#endif
+
+// 校验并解析一帧完整的UBX，len是帧的字节数
+// 返回：0=成功，-1=空指针，-2=同步字不对或不支持的消息，-3=帧不完整，-4=负载长度不对，-5=校验和错误
+int parse_ubx_frame(const uint8_t* frame, uint32_t len, gps_data_t* data) {
+    int ret = ubx_verify_checksum(frame, len);
+    if (ret != 0) {
+        return ret;
+    }
+    if (data == NULL) {
+        return -1;
+    }
+    const uint8_t* payload = frame + UBX_HEADER_SIZE;
+    uint16_t length = ubx_u16(frame + 4);
+    if (frame[2] != UBX_CLASS_NAV) {
+        return -2;
+    }
+    switch (frame[3]) {
+        case UBX_ID_NAV_PVT:
+            return parse_ubx_nav_pvt(payload, length, data);
+        case UBX_ID_NAV_DOP:
+            return parse_ubx_nav_dop(payload, length, data);
+#if GPS_ENABLE_SATELLITES
+        case UBX_ID_NAV_SAT:
+            return parse_ubx_nav_sat(payload, length, data);
+#endif
+        default:
+            return -2;
+    }
+}
+#endif
@@ -0,0 +1,63 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_UBXSOLVE_H
+#define NMEA0183_UBXSOLVE_H
+#include <stdint.h>
+#include "NMEA0183Solve.h"
+
+// u-blox UBX二进制协议：NAV-PVT / NAV-DOP / NAV-SAT 直接填进和NMEA相同的 gps_data_t，
+// 上层通过get_gps_data()看到的内容和收到GGA/RMC/VTG/GLL/ZDA/GSA/GSV时一样
+// 帧格式：0xB5 0x62 class id length(2字节小端) payload ck_a ck_b，校验和是class到payload末尾的8位Fletcher
+// 所有字段按固定偏移小端读取，不需要分词
+
+#define UBX_SYNC_CHAR_1 0xB5
+#define UBX_SYNC_CHAR_2 0x62
+#define UBX_HEADER_SIZE 6          // 同步字+class+id+length
+#define UBX_FRAME_OVERHEAD 8       // 帧头加2字节校验和
+#define UBX_MAX_PAYLOAD 1024       // NAV-SAT每颗卫星12字节，够80颗以上
+
+#define UBX_CLASS_NAV 0x01
+#define UBX_ID_NAV_DOP 0x04
+#define UBX_ID_NAV_PVT 0x07
+#define UBX_ID_NAV_SAT 0x35
+
+#define UBX_NAV_DOP_LENGTH 18
+#define UBX_NAV_PVT_LENGTH 92
+#define UBX_NAV_SAT_HEADER 8       // NAV-SAT固定部分，后面每颗卫星12字节
+#define UBX_NAV_SAT_BLOCK 12
+
+// UBX的gnssId
+#define UBX_GNSS_GPS 0
+#define UBX_GNSS_SBAS 1
+#define UBX_GNSS_GALILEO 2
+#define UBX_GNSS_BEIDOU 3
+#define UBX_GNSS_QZSS 5
+#define UBX_GNSS_GLONASS 6
+
+static inline uint16_t ubx_u16(const uint8_t* p) {
+    return (uint16_t) (p[0] | p[1] << 8);
+}
+static inline uint32_t ubx_u32(const uint8_t* p) {
+    return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16 | (uint32_t) p[3] << 24;
+}
+static inline int32_t ubx_i32(const uint8_t* p) {
+    return (int32_t) ubx_u32(p);
+}
+static inline int16_t ubx_i16(const uint8_t* p) {
+    return (int16_t) ubx_u16(p);
+}
+
+int ubx_verify_checksum(const uint8_t* frame, uint32_t len);
+
+#if GPS_ENABLE_UBX
+int parse_ubx_nav_pvt(const uint8_t* payload, uint16_t length, gps_data_t* data);
+int parse_ubx_nav_dop(const uint8_t* payload, uint16_t length, gps_data_t* data);
+#if GPS_ENABLE_SATELLITES
+int parse_ubx_nav_sat(const uint8_t* payload, uint16_t length, gps_data_t* data);
+#endif
+int parse_ubx_frame(const uint8_t* frame, uint32_t len, gps_data_t* data);
+#endif
+
+#endif // NMEA0183_UBXSOLVE_H
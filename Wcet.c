@@ -0,0 +1,211 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#include "Wcet.h"
+
+#if GPS_ENABLE_WCET
+// 每种语句的一条正常样例
+static const char* const wcet_samples[GPS_SENTENCE_TYPE_COUNT] = {
+    "$GNGGA,094245.000,2844.57254,N,11552.25561,E,1,10,2.3,55.2,M,-6.5,M,,*6C",
+    "$GNGLL,2844.57254,N,11552.25561,E,094245.000,A,A*45",
+    "$GNGSA,A,3,16,26,28,31,194,,,,,,,,4.1,2.3,3.4,1*05",
+    "$GPGSV,3,2,11,26,47,034,21,27,53,177,27,28,25,099,22,31,48,075,30,0*62",
+    "$GNRMC,094245.000,A,2844.57254,N,11552.25561,E,0.21,0.00,071025,,,A,V*0A",
+    "$GNVTG,0.00,T,,M,0.21,N,0.38,K,A*2B",
+    "$GNZDA,094245.000,07,10,2025,00,00*45",
+    "$GPTXT,01,01,01,ANTENNA OPEN*25",
+    "$GPXXX,1,2,3*00",
+};
+
+// 每种语句（语句头之后）的字段数
+static const int wcet_field_counts[GPS_SENTENCE_TYPE_COUNT] = {14, 7, 18, 20, 13, 9, 6, 4, 4};
+
+// 填进每个字段的刁钻值：空、单字符、负数、最大时间/坐标、超长小数、超过临时缓冲区的长数字、前导空白等
+static const char* const wcet_fields[] = {
+    "", "9", "A", "N", "-1", "99", ".", " +0.5", "235959.999", "9000.0000000", "18000.0000000",
+    "99999.99999999", "-9999.9999", "0.000000000000000001", "1234567890123456789012345",
+};
+#define WCET_FIELD_PATTERNS (int) (sizeof(wcet_fields) / sizeof(wcet_fields[0]))
+
+// 生成的输入：样例、每种字段值各一条、塞满最长数字、全是逗号、没有校验和、超长
+#define WCET_VARIANTS (WCET_FIELD_PATTERNS + 5)
+
+static void wcet_append_checksum(char* out, int len) {
+    uint8_t sum = 0;
+    for (int i = 1; i < len; i++) {
+        sum ^= (uint8_t) out[i];
+    }
+    static const char hex[] = "0123456789ABCDEF";
+    out[len] = '*';
+    out[len + 1] = hex[sum >> 4];
+    out[len + 2] = hex[sum & 0x0F];
+    out[len + 3] = '\0';
+}
+
+// 生成第variant条输入，返回0表示没有这一条；out至少NMEA_MAX_SENTENCE+8字节
+static int wcet_build(char* out, int type, int variant) {
+    const char* name = type < GPS_SENTENCE_OTHER ? gps_sentence_type_name(type) : "XXX";
+    int limit = NMEA_MAX_SENTENCE; // $之后、*之前最多这么长
+    if (variant == 0) {
+        strncpy(out, wcet_samples[type], NMEA_MAX_SENTENCE + 7);
+        out[NMEA_MAX_SENTENCE + 7] = '\0';
+        return 1;
+    }
+
+    int len = 0;
+    out[len++] = '$';
+    out[len++] = 'G';
+    out[len++] = 'P';
+    memcpy(out + len, name, 3);
+    len += 3;
+
+    variant--;
+    if (variant <= WCET_FIELD_PATTERNS) {
+        // 每个字段都是同一个值；最后一种是最长数字一直塞到语句长度上限
+        const char* field = wcet_fields[variant < WCET_FIELD_PATTERNS ? variant : WCET_FIELD_PATTERNS - 4];
+        int field_len = (int) strlen(field);
+        int count = variant < WCET_FIELD_PATTERNS ? wcet_field_counts[type] : NMEA_MAX_SENTENCE;
+        for (int i = 0; i < count && len + 1 + field_len < limit; i++) {
+            out[len++] = ',';
+            memcpy(out + len, field, field_len);
+            len += field_len;
+        }
+        wcet_append_checksum(out, len);
+        return 1;
+    }
+
+    variant -= WCET_FIELD_PATTERNS + 1;
+    switch (variant) {
+        case 0: // 全是逗号
+            while (len < limit - 1) {
+                out[len++] = ',';
+            }
+            wcet_append_checksum(out, len);
+            return 1;
+        case 1: // 没有校验和
+            strncpy(out, wcet_samples[type], NMEA_MAX_SENTENCE);
+            out[NMEA_MAX_SENTENCE] = '\0';
+            *strchr(out, '*') = '\0';
+            return 1;
+        case 2: // 超过长度上限
+            while (len < NMEA_MAX_SENTENCE + 4) {
+                out[len] = len % 2 ? ',' : '9';
+                len++;
+            }
+            wcet_append_checksum(out, len);
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// 被测路径：分类、校验和、解析，和GPSSolve里每条语句走的一样
+static void wcet_run(const char* sentence) {
+    int type = gps_sentence_type_index(sentence);
+    if (nmea_verify_checksum(sentence) != 0) {
+        return;
+    }
+    switch (type) {
+#if GPS_ENABLE_GGA
+        case GPS_SENTENCE_GGA: {
+            static gps_gga_t gga;
+            parse_gpgga(sentence, &gga);
+            break;
+        }
+#endif
+#if GPS_ENABLE_GLL
+        case GPS_SENTENCE_GLL: {
+            static gps_gll_t gll;
+            parse_gpgll(sentence, &gll);
+            break;
+        }
+#endif
+#if GPS_ENABLE_GSA
+        case GPS_SENTENCE_GSA: {
+            static gps_gsa_t gsa;
+            parse_gpgsa(sentence, &gsa);
+            break;
+        }
+#endif
+#if GPS_ENABLE_GSV
+        case GPS_SENTENCE_GSV: {
+            static gps_gsv_t gsv;
+            parse_gpgsv_single(sentence, &gsv);
+            break;
+        }
+#endif
+#if GPS_ENABLE_RMC
+        case GPS_SENTENCE_RMC: {
+            static gps_rmc_t rmc;
+            parse_gprmc(sentence, &rmc);
+            break;
+        }
+#endif
+#if GPS_ENABLE_VTG
+        case GPS_SENTENCE_VTG: {
+            static gps_vtg_t vtg;
+            parse_gpvtg(sentence, &vtg);
+            break;
+        }
+#endif
+#if GPS_ENABLE_ZDA
+        case GPS_SENTENCE_ZDA: {
+            static gps_zda_t zda;
+            parse_gpzda(sentence, &zda);
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+}
+
+void gps_wcet_reset(gps_wcet_result_t* result) {
+    memset(result, 0, sizeof(gps_wcet_result_t));
+    result->min_cycles = UINT64_MAX;
+}
+
+// 测量一条语句repeat次，结果累加到result里
+int gps_wcet_measure_sentence(const char* sentence, uint32_t repeat, gps_wcet_result_t* result) {
+    if (sentence == NULL || result == NULL) {
+        return -1;
+    }
+    for (uint32_t i = 0; i < repeat; i++) {
+        uint64_t start = GPS_WCET_CYCLES();
+        wcet_run(sentence);
+        uint64_t cycles = GPS_WCET_CYCLES() - start;
+
+        result->samples++;
+        result->total_cycles += cycles;
+        if (cycles < result->min_cycles) {
+            result->min_cycles = cycles;
+        }
+        if (cycles > result->max_cycles) {
+            result->max_cycles = cycles;
+            strncpy(result->worst_input, sentence, sizeof(result->worst_input) - 1);
+            result->worst_input[sizeof(result->worst_input) - 1] = '\0';
+        }
+    }
+    return 0;
+}
+
+// 用内置的刁钻输入测量某种语句，返回测量的输入条数
+int gps_wcet_measure_type(int type, uint32_t repeat, gps_wcet_result_t* result) {
+    if (result == NULL) {
+        return -1;
+    }
+    if (type < 0 || type >= GPS_SENTENCE_TYPE_COUNT) {
+        return -2;
+    }
+    char input[NMEA_MAX_SENTENCE + 8];
+    int inputs = 0;
+    for (int variant = 0; variant < WCET_VARIANTS; variant++) {
+        if (wcet_build(input, type, variant)) {
+            gps_wcet_measure_sentence(input, repeat, result);
+            inputs++;
+        }
+    }
+    return inputs;
+}
+#endif
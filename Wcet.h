@@ -0,0 +1,44 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+#ifndef NMEA0183_WCET_H
+#define NMEA0183_WCET_H
+#include <stdint.h>
+#include <string.h>
+#include "NMEA0183Solve.h"
+#include "SatelliteSolve.h"
+#include "Metrics.h"
+
+// 单条语句最坏执行时间测量：对每种语句生成一组刁钻输入（字段全满、全空、超长小数、满逗号、
+// 各种截断等），反复执行 校验和+解析，记录最大周期数和对应的输入
+// 建议在目标板上关中断、打开GPS_BOUNDED_PARSE后运行，把结果加上余量作为任务的时间预算
+// 编译时用 -DGPS_ENABLE_WCET=1 打开
+
+#ifndef GPS_ENABLE_WCET
+#define GPS_ENABLE_WCET 0
+#endif
+
+// 周期计数器，Cortex-M上可以定义成 (DWT->CYCCNT)
+#ifndef GPS_WCET_CYCLES
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define GPS_WCET_CYCLES() __rdtsc()
+#else
+#define GPS_WCET_CYCLES() gps_monotonic_ns()
+#endif
+#endif
+
+typedef struct {
+    uint64_t max_cycles;       // 最坏情况
+    uint64_t min_cycles;
+    uint64_t total_cycles;
+    uint32_t samples;          // 测量次数
+    char worst_input[NMEA_MAX_SENTENCE + 8]; // 耗时最长的输入
+} gps_wcet_result_t;
+
+void gps_wcet_reset(gps_wcet_result_t* result);
+int gps_wcet_measure_sentence(const char* sentence, uint32_t repeat, gps_wcet_result_t* result);
+int gps_wcet_measure_type(int type, uint32_t repeat, gps_wcet_result_t* result);
+
+#endif // NMEA0183_WCET_H
@@ -0,0 +1,80 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+// StreamDemux的分帧回归：没有行尾的半行或者一个孤立的'!'/'$'后面紧跟完整语句时，
+// 半行要记为跳过，后面的语句照常分出来，经add_bytes+solve_once也要解析成功
+
+#include "GPSSolve.h"
+#include "StreamDemux.h"
+
+#define RMC_SENTENCE "$GNRMC,094332.400,A,2844.57254,N,11552.25561,E,0.21,0.00,071025,,,A,V*0F"
+
+static int failures;
+
+static void check_true(const char* label, int condition) {
+    if (!condition) {
+        printf("FAIL %s\n", label);
+        failures++;
+    }
+}
+
+// input里第一帧应该是RMC_SENTENCE，前面跳过skipped个字节
+static void check_frame(const char* label, const char* input, uint32_t skipped) {
+    gps_frame_t frame;
+    int ret = gps_demux_next((const uint8_t*) input, (uint32_t) strlen(input), &frame);
+    uint32_t length = (uint32_t) strlen(RMC_SENTENCE);
+    if (ret != GPS_DEMUX_FRAME || frame.protocol != GPS_PROTOCOL_NMEA || frame.skipped != skipped ||
+        frame.length != length || memcmp(frame.data, RMC_SENTENCE, length) != 0 ||
+        frame.consumed != strlen(input)) {
+        printf("FAIL %s: ret=%d skipped=%u length=%u consumed=%u\n", label, ret, frame.skipped, frame.length,
+               frame.consumed);
+        failures++;
+    }
+}
+
+// 第minute分的RMC，带正确的校验和；每个用例用不同的时间，免得上一个用例留下的结果冒充这一次的
+static void make_rmc(char* out, size_t size, int minute) {
+    int len = snprintf(out, size, "$GNRMC,09%02d32.400,A,2844.57254,N,11552.25561,E,0.21,0.00,071025,,,A,V", minute);
+    uint8_t sum = 0;
+    for (int i = 1; i < len; i++) {
+        sum ^= (uint8_t) out[i];
+    }
+    snprintf(out + len, size - len, "*%02X\r\n", sum);
+}
+
+// 经过完整的解析流程：先写prefix再写RMC语句，split时两次写入之间solve_once一次
+static void check_engine(const char* label, const char* prefix, int split, int minute) {
+    char rmc[NMEA_MAX_SENTENCE + 8];
+    make_rmc(rmc, sizeof(rmc), minute);
+    add_bytes(prefix, (uint32_t) strlen(prefix));
+    if (split) {
+        solve_once();
+    }
+    add_bytes(rmc, (uint32_t) strlen(rmc));
+    solve_once();
+    const gps_data_t* data = get_gps_data();
+    if (!data->rmc.has_time || data->rmc.hour != 9 || data->rmc.minute != minute) {
+        printf("FAIL %s: rmc.has_time=%d %02d:%02d\n", label, data->rmc.has_time, data->rmc.hour, data->rmc.minute);
+        failures++;
+    }
+}
+
+int main(void) {
+    check_frame("cut-off line", "$GNGGA,0927" RMC_SENTENCE "\r\n", 11);
+    check_frame("stray '!'", "!" RMC_SENTENCE "\r\n", 1);
+    check_frame("noise before '$'", "xy!z" RMC_SENTENCE "\n", 4);
+
+    // 半行后面的'$'还没到时只能等
+    gps_frame_t frame;
+    const char* partial = "$GNGGA,0927";
+    check_true("partial waits", gps_demux_next((const uint8_t*) partial, (uint32_t) strlen(partial), &frame) ==
+                                GPS_DEMUX_NEED_MORE && frame.consumed == 0);
+
+    check_engine("engine, one write", "$GNGGA,0927", 0, 41);
+    check_engine("engine, split writes", "$GNGGA,0927", 1, 42);
+    check_engine("engine, stray '!'", "!", 1, 43);
+
+    printf("demux: %d failure(s)\n", failures);
+    return failures == 0 ? 0 : 1;
+}
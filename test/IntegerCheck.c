@@ -0,0 +1,319 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+// 浮点模式和整数模式（GPS_INTEGER_ONLY）的解析结果对照
+// 同一份源码编两次：浮点版用 write 把固定语料的解析结果按整数模式的定标单位写进文件，
+// 整数版用 compare 读回来逐项比较，每个字段最多差最后一位（1个定标单位）；
+// calculate_distance 的结果和浮点版的Haversine比较，误差不超过表里每组点给出的容差
+// 两种模式都会检查语料里每条语句的校验和和解析返回值
+// 用法：IntegerCheck write <文件> | IntegerCheck compare <文件>
+
+#include <inttypes.h>
+#include "NMEA0183Solve.h"
+
+#if GPS_INTEGER_ONLY
+#define FIXED(v, KIND) ((int64_t) (v))
+#else
+// 和FixedPoint.h整数模式的单位一致；时间在浮点模式下是小时，换成毫秒
+#define CHECK_SCALE_DEGREE 1e7
+#define CHECK_SCALE_MINUTE 1e7
+#define CHECK_SCALE_TOD 3600000.0
+#define CHECK_SCALE_SECOND 1e3
+#define CHECK_SCALE_SPEED 1e3
+#define CHECK_SCALE_ANGLE 1e2
+#define CHECK_SCALE_DOP 1e2
+#define CHECK_SCALE_METER 1e3
+#define CHECK_SCALE_DISTANCE 1e2
+#define FIXED(v, KIND) ((int64_t) llround((v) * CHECK_SCALE_##KIND))
+#endif
+
+static const char* corpus[] = {
+    "$GPGGA,123519.00,4807.0381,N,01131.0002,E,1,08,0.9,545.4,M,46.9,M,,*6A",
+    "$GNGGA,094245.000,2844.57254,N,11552.25561,E,1,10,2.3,55.2,M,-6.5,M,,*6C",
+    "$GPGGA,235959.999,3351.87317,S,15112.60419,E,2,12,0.65,-12.345,M,22.1,M,3.5,0120*4E",
+    "$GNGGA,000000.05,0000.00001,N,00000.00001,W,4,24,0.51,0.004,M,-0.001,M,1.25,1023*52",
+    "$GPGGA,180102.37,5959.99999,N,17959.99999,W,5,05,12.75,8848.86,M,-28.7,M,,*51",
+    "$GPRMC,123519.00,A,4807.0381,N,01131.0002,E,022.4,084.4,230394,003.1,W,A*2A",
+    "$GNRMC,094245.000,A,2844.57254,N,11552.25561,E,0.21,0.00,071025,,,A,V*0A",
+    "$GPRMC,235959.999,V,3351.87317,S,15112.60419,E,999.9,359.99,311299,180.0,E,D*37",
+    "$GNRMC,071530.125,A,6530.12345,N,02215.67891,W,12.345,270.05,290224,0.5,E,E*04",
+    "$GPGLL,4916.45,N,12311.12,W,225444.00,A,A*72",
+    "$GNGLL,2844.57254,N,11552.25561,E,094245.000,A,A*45",
+    "$GPGLL,3351.87317,S,15112.60419,E,235959.999,V,N*56",
+    "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A*25",
+    "$GNVTG,0.00,T,,M,0.21,N,0.38,K,A*2B",
+    "$GPVTG,359.99,T,1.23,M,999.999,N,1851.998,K,D*1C",
+    "$GPZDA,201530.00,04,07,2002,-05,30*4B",
+    "$GNZDA,094245.000,07,10,2025,00,00*45",
+    "$GPZDA,235959.999,31,12,1999,13,00*55",
+};
+
+// 两点都是GLL里的"纬度,N/S,经度,E/W"；tolerance_ppm是整数近似相对Haversine的容差（百万分之一）
+// 纬度60度以内、两百公里以内按calculate_distance注释里的0.01%，三四百公里放到0.02%，高纬度放到0.1%
+typedef struct {
+    const char* from;
+    const char* to;
+    int tolerance_ppm;
+} distance_case_t;
+
+static const distance_case_t distance_cases[] = {
+    {"4807.0381,N,01131.0002,E", "4807.0391,N,01131.0015,E", 100},   // 约2.5米
+    {"2844.57254,N,11552.25561,E", "2845.12345,N,11553.01234,E", 100},
+    {"3351.87317,S,15112.60419,E", "3412.00000,S,15054.00000,E", 100},
+    {"0000.50000,S,00000.50000,W", "0000.50000,N,00000.50000,E", 100}, // 跨赤道和本初子午线
+    {"5130.00000,N,17959.50000,W", "5130.00000,N,17959.50000,E", 100}, // 跨180度经线
+    {"5900.00000,N,01000.00000,E", "5930.00000,N,01200.00000,E", 100},
+    {"4000.00000,N,07400.00000,W", "4230.00000,N,07100.00000,W", 200}, // 约370公里
+    {"7500.00000,N,02000.00000,E", "7600.00000,N,02500.00000,E", 1000}, // 高纬度
+};
+
+static FILE* reference;
+static int writing;
+static int failures;
+
+// 写模式：记下一项；比较模式：读出参考文件的同一项，差超过1个定标单位就报错
+static void check_value(const char* label, int64_t value) {
+    if (writing) {
+        fprintf(reference, "%s %" PRId64 "\n", label, value);
+        return;
+    }
+    char expected_label[64];
+    int64_t expected;
+    if (fscanf(reference, "%63s %" SCNd64, expected_label, &expected) != 2 ||
+        strcmp(expected_label, label) != 0) {
+        printf("FAIL %s: reference file out of step\n", label);
+        failures++;
+        return;
+    }
+    if (llabs(value - expected) > 1) {
+        printf("FAIL %s: %" PRId64 " expected %" PRId64 "\n", label, value, expected);
+        failures++;
+    }
+}
+
+// 两种模式都要满足的条件，不依赖参考文件
+static void check_true(const char* label, int condition) {
+    if (!condition) {
+        printf("FAIL %s\n", label);
+        failures++;
+    }
+}
+
+static void check_gga(const char* sentence) {
+    gps_gga_t gga;
+    check_true("gga.parse", parse_gpgga(sentence, &gga) == 0);
+    check_value("gga.has_time", gga.has_time);
+    if (gga.has_time) {
+        check_value("gga.utc_time", FIXED(gga.utc_time, TOD));
+        check_value("gga.hour", gga.hour);
+        check_value("gga.minute", gga.minute);
+        check_value("gga.second", FIXED(gga.second, SECOND));
+    }
+    check_value("gga.has_latitude", gga.has_latitude);
+    if (gga.has_latitude) {
+        check_value("gga.latitude", FIXED(gga.latitude, DEGREE));
+        check_value("gga.latitude_minutes", FIXED(gga.latitude_minutes, MINUTE));
+    }
+    check_value("gga.has_longitude", gga.has_longitude);
+    if (gga.has_longitude) {
+        check_value("gga.longitude", FIXED(gga.longitude, DEGREE));
+        check_value("gga.longitude_minutes", FIXED(gga.longitude_minutes, MINUTE));
+    }
+    check_value("gga.fix_quality", gga.fix_quality);
+    check_value("gga.satellites_used", gga.satellites_used);
+    check_value("gga.has_hdop", gga.has_hdop);
+    if (gga.has_hdop) {
+        check_value("gga.hdop", FIXED(gga.hdop, DOP));
+    }
+    check_value("gga.has_altitude", gga.has_altitude);
+    if (gga.has_altitude) {
+        check_value("gga.altitude", FIXED(gga.altitude, METER));
+    }
+    check_value("gga.has_geoid_height", gga.has_geoid_height);
+    if (gga.has_geoid_height) {
+        check_value("gga.geoid_height", FIXED(gga.geoid_height, METER));
+    }
+    check_value("gga.has_diff_age", gga.has_diff_age);
+    if (gga.has_diff_age) {
+        check_value("gga.diff_age", FIXED(gga.diff_age, SECOND));
+        check_value("gga.diff_station_id", gga.diff_station_id);
+    }
+}
+
+static void check_rmc(const char* sentence) {
+    gps_rmc_t rmc;
+    check_true("rmc.parse", parse_gprmc(sentence, &rmc) == 0);
+    check_value("rmc.has_time", rmc.has_time);
+    if (rmc.has_time) {
+        check_value("rmc.utc_time", FIXED(rmc.utc_time, TOD));
+        check_value("rmc.second", FIXED(rmc.second, SECOND));
+    }
+    check_value("rmc.status", rmc.status);
+    check_value("rmc.has_latitude", rmc.has_latitude);
+    if (rmc.has_latitude) {
+        check_value("rmc.latitude", FIXED(rmc.latitude, DEGREE));
+    }
+    check_value("rmc.has_longitude", rmc.has_longitude);
+    if (rmc.has_longitude) {
+        check_value("rmc.longitude", FIXED(rmc.longitude, DEGREE));
+    }
+    check_value("rmc.has_speed", rmc.has_speed);
+    if (rmc.has_speed) {
+        check_value("rmc.speed_over_ground", FIXED(rmc.speed_over_ground, SPEED));
+    }
+    check_value("rmc.has_course", rmc.has_course);
+    if (rmc.has_course) {
+        check_value("rmc.course_over_ground", FIXED(rmc.course_over_ground, ANGLE));
+    }
+    check_value("rmc.has_date", rmc.has_date);
+    if (rmc.has_date) {
+        check_value("rmc.day", rmc.day);
+        check_value("rmc.month", rmc.month);
+        check_value("rmc.year", rmc.year);
+    }
+    check_value("rmc.has_magnetic_variation", rmc.has_magnetic_variation);
+    if (rmc.has_magnetic_variation) {
+        check_value("rmc.magnetic_variation", FIXED(rmc.magnetic_variation, ANGLE));
+        check_value("rmc.is_magnetic_east", rmc.is_magnetic_east);
+    }
+    check_value("rmc.mode_indicator", rmc.mode_indicator);
+}
+
+static void check_gll(const char* sentence) {
+    gps_gll_t gll;
+    check_true("gll.parse", parse_gpgll(sentence, &gll) == 0);
+    check_value("gll.has_latitude", gll.has_latitude);
+    if (gll.has_latitude) {
+        check_value("gll.latitude", FIXED(gll.latitude, DEGREE));
+    }
+    check_value("gll.has_longitude", gll.has_longitude);
+    if (gll.has_longitude) {
+        check_value("gll.longitude", FIXED(gll.longitude, DEGREE));
+    }
+    check_value("gll.has_time", gll.has_time);
+    if (gll.has_time) {
+        check_value("gll.utc_time", FIXED(gll.utc_time, TOD));
+        check_value("gll.second", FIXED(gll.second, SECOND));
+    }
+    check_value("gll.data_valid", gll.data_valid);
+    check_value("gll.mode_indicator", gll.mode_indicator);
+}
+
+static void check_vtg(const char* sentence) {
+    gps_vtg_t vtg;
+    check_true("vtg.parse", parse_gpvtg(sentence, &vtg) == 0);
+    check_value("vtg.has_true_course", vtg.has_true_course);
+    if (vtg.has_true_course) {
+        check_value("vtg.course_true", FIXED(vtg.course_true, ANGLE));
+    }
+    check_value("vtg.has_magnetic_course", vtg.has_magnetic_course);
+    if (vtg.has_magnetic_course) {
+        check_value("vtg.course_magnetic", FIXED(vtg.course_magnetic, ANGLE));
+    }
+    check_value("vtg.has_speed_knots", vtg.has_speed_knots);
+    if (vtg.has_speed_knots) {
+        check_value("vtg.speed_knots", FIXED(vtg.speed_knots, SPEED));
+    }
+    check_value("vtg.has_speed_kmh", vtg.has_speed_kmh);
+    if (vtg.has_speed_kmh) {
+        check_value("vtg.speed_kmh", FIXED(vtg.speed_kmh, SPEED));
+    }
+    check_value("vtg.mode", vtg.mode);
+}
+
+static void check_zda(const char* sentence) {
+    gps_zda_t zda;
+    check_true("zda.parse", parse_gpzda(sentence, &zda) == 0);
+    check_value("zda.has_time", zda.has_time);
+    if (zda.has_time) {
+        check_value("zda.utc_time", FIXED(zda.utc_time, TOD));
+        check_value("zda.second", FIXED(zda.second, SECOND));
+    }
+    check_value("zda.has_date", zda.has_date);
+    if (zda.has_date) {
+        check_value("zda.day", zda.day);
+        check_value("zda.month", zda.month);
+        check_value("zda.year", zda.year);
+    }
+    check_value("zda.has_timezone", zda.has_timezone);
+    if (zda.has_timezone) {
+        check_value("zda.local_timezone_hours", zda.local_timezone_hours);
+        check_value("zda.local_timezone_minutes", zda.local_timezone_minutes);
+    }
+}
+
+// 拼一条带正确校验和的GLL语句再解析，得到calculate_distance要的输入
+static void make_gll(const char* position, gps_gll_t* gll) {
+    char sentence[NMEA_MAX_SENTENCE];
+    int len = snprintf(sentence, sizeof(sentence), "$GPGLL,%s,000000.00,A,A", position);
+    uint8_t sum = 0;
+    for (int i = 1; i < len; i++) {
+        sum ^= (uint8_t) sentence[i];
+    }
+    snprintf(sentence + len, sizeof(sentence) - len, "*%02X", sum);
+    check_true("distance.parse", parse_gpgll(sentence, gll) == 0);
+}
+
+static void check_distance(const distance_case_t* test) {
+    gps_gll_t from, to;
+    make_gll(test->from, &from);
+    make_gll(test->to, &to);
+    int64_t distance = FIXED(calculate_distance(&from, &to), DISTANCE);
+    int64_t back = FIXED(calculate_distance(&to, &from), DISTANCE);
+    check_true("distance.symmetric", llabs(distance - back) <= 1);
+    if (writing) {
+        fprintf(reference, "distance %" PRId64 "\n", distance);
+        return;
+    }
+    char label[16];
+    int64_t expected;
+    if (fscanf(reference, "%15s %" SCNd64, label, &expected) != 2 || strcmp(label, "distance") != 0) {
+        printf("FAIL distance: reference file out of step\n");
+        failures++;
+        return;
+    }
+    // 厘米；另加3厘米：两个点的坐标各量化到1e-7度（约1.1厘米），再加整数运算的截断
+    int64_t tolerance = expected * test->tolerance_ppm / 1000000 + 3;
+    if (llabs(distance - expected) > tolerance) {
+        printf("FAIL distance %s -> %s: %" PRId64 " cm expected %" PRId64 " cm (+-%" PRId64 ")\n",
+               test->from, test->to, distance, expected, tolerance);
+        failures++;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3 || (strcmp(argv[1], "write") != 0 && strcmp(argv[1], "compare") != 0)) {
+        fprintf(stderr, "usage: %s write|compare <file>\n", argv[0]);
+        return 2;
+    }
+    writing = strcmp(argv[1], "write") == 0;
+    reference = fopen(argv[2], writing ? "w" : "r");
+    if (reference == NULL) {
+        perror(argv[2]);
+        return 2;
+    }
+
+    for (size_t i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++) {
+        const char* sentence = corpus[i];
+        check_true(sentence, nmea_verify_checksum(sentence) == 0);
+        if (strncmp(sentence + 3, "GGA", 3) == 0) {
+            check_gga(sentence);
+        } else if (strncmp(sentence + 3, "RMC", 3) == 0) {
+            check_rmc(sentence);
+        } else if (strncmp(sentence + 3, "GLL", 3) == 0) {
+            check_gll(sentence);
+        } else if (strncmp(sentence + 3, "VTG", 3) == 0) {
+            check_vtg(sentence);
+        } else {
+            check_zda(sentence);
+        }
+    }
+    for (size_t i = 0; i < sizeof(distance_cases) / sizeof(distance_cases[0]); i++) {
+        check_distance(&distance_cases[i]);
+    }
+    fclose(reference);
+
+    printf("%s: %s, %d failure(s)\n", argv[1], GPS_INTEGER_ONLY ? "integer" : "double", failures);
+    return failures == 0 ? 0 : 1;
+}
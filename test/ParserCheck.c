@@ -0,0 +1,151 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+// C++封装（NMEA0183.hpp的nmea0183::Parser）和C引擎（add_bytes+solve_once）对照
+// NmeaGen生成带错误注入的数据流（10Hz，错误校验和、截断、乱码各20000ppm），每个历元的字节整块写给C引擎，
+// 切成三段喂给Parser，两边各发布一次，快照逐字节比较
+// 前一半历元先核对两边的语句统计都和生成器注入的错误数对上；后一半在语句之间再插入分帧的边界情况
+// （半行、孤立的'!'、不到7字节的短行、行中的控制字符、'!'开头的语句），只比较两边互相一致
+// 用法：ParserCheck [历元数]
+
+#include <inttypes.h>
+#include "GPSSolve.h"
+#include "NmeaGen.h"
+
+void parser_facade_feed(const char* bytes, size_t len);
+const gps_data_t* parser_facade_publish(void);
+void parser_facade_outcomes(uint64_t* outcomes, int count);
+
+static char epoch_buffer[GPS_GEN_EPOCH_MAX];
+static char noisy_buffer[GPS_GEN_EPOCH_MAX * 2];
+
+static const char* const framing_noise[] = {
+    "$GNGGA,0927",                                                // 没有行尾的半行，后面的'$'重新开始
+    "!",                                                          // 孤立的起始符
+    "$GP\r\n",                                                    // 短行，两边都不计数
+    "$GNTXT,01,01,\x01" "02,noise*00\r\n",                        // 行中的控制字符，整行作废
+    "$GNVTG,\r\r\n",                                               // 没有校验和，只去掉最后一个'\r'
+    "!AIVDM,1,1,,A,15M67FC000G?ufbE`FepT@3n00Sa,0*00\r\n",        // '!'开头的语句，校验和错误
+};
+#define FRAMING_NOISE_COUNT (sizeof(framing_noise) / sizeof(framing_noise[0]))
+
+// 每隔几行在行尾后面插入一段framing_noise，返回新的长度
+static int add_framing_noise(const char* in, int len, char* out, uint32_t* rng) {
+    int n = 0;
+    for (int i = 0; i < len; i++) {
+        out[n++] = in[i];
+        if (in[i] == '\n') {
+            *rng = *rng * 1103515245u + 12345u;
+            uint32_t pick = *rng >> 16;
+            if (pick % 4 == 0) {
+                const char* noise = framing_noise[(pick / 4) % FRAMING_NOISE_COUNT];
+                size_t noise_len = strlen(noise);
+                memcpy(out + n, noise, noise_len);
+                n += (int) noise_len;
+            }
+        }
+    }
+    return n;
+}
+
+static void count_engine_outcomes(uint64_t outcomes[GPS_OUTCOME_COUNT], gps_metrics_snapshot_t* metrics) {
+    memset(outcomes, 0, sizeof(uint64_t) * GPS_OUTCOME_COUNT);
+    gps_metrics_snapshot(metrics);
+    for (int talker = 0; talker < GPS_TALKER_COUNT; talker++) {
+        for (int type = 0; type < GPS_SENTENCE_TYPE_COUNT; type++) {
+            for (int outcome = 0; outcome < GPS_OUTCOME_COUNT; outcome++) {
+                outcomes[outcome] += metrics->sentences[talker][type].outcomes[outcome];
+            }
+        }
+    }
+}
+
+// 两边的统计一致，返回不一致的项数
+static int compare_outcomes(const char* label) {
+    uint64_t engine[GPS_OUTCOME_COUNT];
+    uint64_t facade[GPS_OUTCOME_COUNT];
+    gps_metrics_snapshot_t metrics;
+    count_engine_outcomes(engine, &metrics);
+    parser_facade_outcomes(facade, GPS_OUTCOME_COUNT);
+    int failures = 0;
+    printf("%-10s engine   facade\n", label);
+    for (int outcome = 0; outcome < GPS_OUTCOME_COUNT; outcome++) {
+        printf("outcome %d %7" PRIu64 " %8" PRIu64 "\n", outcome, engine[outcome], facade[outcome]);
+        if (engine[outcome] != facade[outcome]) {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char* argv[]) {
+    uint32_t epochs = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : 3000;
+    gps_gen_config_t config;
+    gps_gen_default_config(&config);
+    config.rate_hz = 10;
+    config.bad_checksum_ppm = 20000;
+    config.truncate_ppm = 20000;
+    config.garbage_ppm = 20000;
+    static gps_gen_t gen;
+    if (gps_gen_init(&gen, &config) != 0) {
+        printf("FAIL gps_gen_init\n");
+        return 1;
+    }
+
+    int failures = 0;
+    uint32_t differing = 0;
+    uint32_t rng = 1;
+    for (uint32_t i = 0; i < epochs; i++) {
+        int noisy = i >= epochs / 2;
+        if (i == epochs / 2) {
+            // 到这里为止没有额外的噪声，两边的统计都应该和生成器注入的错误数对上
+            failures += compare_outcomes("clean");
+            uint64_t engine[GPS_OUTCOME_COUNT];
+            gps_metrics_snapshot_t metrics;
+            count_engine_outcomes(engine, &metrics);
+            gps_gen_stats_t stats;
+            gps_gen_get_stats(&gen, &stats);
+            if (engine[GPS_OUTCOME_CHECKSUM_FAILED] != stats.bad_checksums ||
+                engine[GPS_OUTCOME_TRUNCATED] != stats.truncated ||
+                engine[GPS_OUTCOME_PARSED] != stats.sentences - stats.bad_checksums - stats.truncated ||
+                metrics.unframed_bytes != stats.garbage_bytes) {
+                printf("FAIL generator injected %" PRIu64 " bad checksums, %" PRIu64 " truncated, %" PRIu64
+                       " garbage bytes in %" PRIu64 " sentences; engine skipped %" PRIu64 " bytes\n",
+                       stats.bad_checksums, stats.truncated, stats.garbage_bytes, stats.sentences,
+                       metrics.unframed_bytes);
+                failures++;
+            }
+        }
+        int len = gps_gen_epoch(&gen, epoch_buffer, sizeof(epoch_buffer));
+        const char* bytes = epoch_buffer;
+        if (noisy && len > 0) {
+            len = add_framing_noise(epoch_buffer, len, noisy_buffer, &rng);
+            bytes = noisy_buffer;
+        }
+        if (len <= 0 || add_bytes(bytes, (uint32_t) len) != (uint32_t) len) {
+            printf("FAIL epoch %" PRIu32 ": %d bytes did not fit the input ring\n", i, len);
+            return 1;
+        }
+        solve_once();
+        size_t first = (size_t) len / 3;
+        size_t second = (size_t) len * 2 / 3;
+        parser_facade_feed(bytes, first);
+        parser_facade_feed(bytes + first, second - first);
+        parser_facade_feed(bytes + second, (size_t) len - second);
+        const gps_data_t* facade = parser_facade_publish();
+        if (memcmp(get_gps_data(), facade, sizeof(gps_data_t)) != 0) {
+            if (differing == 0) {
+                printf("FAIL epoch %" PRIu32 ": snapshots differ\n", i);
+            }
+            differing++;
+        }
+    }
+    if (differing > 0) {
+        printf("FAIL %" PRIu32 " of %" PRIu32 " snapshots differ\n", differing, epochs);
+        failures++;
+    }
+    failures += compare_outcomes("noisy");
+    printf("parser: %d failure(s)\n", failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+// 给ParserCheck.c用的C接口：C++封装的nmea0183::Parser包成几个C函数
+// Metrics.h等头文件用了C11的<stdatomic.h>，C++里不能包含，所以对照程序的主体写成C
+
+#include "NMEA0183.hpp"
+
+static nmea0183::Parser parser;
+
+extern "C" {
+
+void parser_facade_feed(const char* bytes, size_t len) {
+    parser.feed(std::string_view(bytes, len));
+}
+
+const gps_data_t* parser_facade_publish(void) {
+    return &parser.publish();
+}
+
+void parser_facade_outcomes(uint64_t* outcomes, int count) {
+    for (int i = 0; i < count; i++) {
+        outcomes[i] = parser.counters().outcomes[i];
+    }
+}
+
+}
@@ -0,0 +1,42 @@
+//
+// Created by Konodoki on 2026/10/19.
+//
+
+// Wcet.c的冒烟测试：每种语句用内置的刁钻输入各跑repeat次，打印最短/平均/最长周期数和最坏输入
+// 只检查测量本身能跑完、结果自洽；周期数和机器有关，这里不设上限
+// 用法：WcetCheck [repeat]
+
+#include <inttypes.h>
+#include "Wcet.h"
+
+#if !GPS_ENABLE_WCET
+#error "WcetCheck needs GPS_ENABLE_WCET=1"
+#endif
+
+int main(int argc, char* argv[]) {
+    uint32_t repeat = argc > 1 ? (uint32_t) strtoul(argv[1], NULL, 10) : 100;
+    if (repeat == 0) {
+        repeat = 1;
+    }
+    int failures = 0;
+    for (int type = 0; type < GPS_SENTENCE_TYPE_COUNT; type++) {
+        gps_wcet_result_t result;
+        gps_wcet_reset(&result);
+        int inputs = gps_wcet_measure_type(type, repeat, &result);
+        const char* name = type < GPS_SENTENCE_OTHER ? gps_sentence_type_name(type) : "other";
+        if (inputs <= 0 || result.samples != (uint32_t) inputs * repeat ||
+            result.min_cycles > result.max_cycles || result.worst_input[0] != '$') {
+            printf("FAIL %s: inputs=%d samples=%" PRIu32 "\n", name, inputs, result.samples);
+            failures++;
+            continue;
+        }
+        printf("%-5s inputs=%-3d min=%-8" PRIu64 " avg=%-8" PRIu64 " max=%-8" PRIu64 " worst=%s\n", name, inputs,
+               result.min_cycles, result.total_cycles / result.samples, result.max_cycles, result.worst_input);
+    }
+    if (gps_wcet_measure_type(GPS_SENTENCE_TYPE_COUNT, repeat, NULL) != -1) {
+        printf("FAIL NULL result not rejected\n");
+        failures++;
+    }
+    printf("wcet: %d failure(s)\n", failures);
+    return failures == 0 ? 0 : 1;
+}